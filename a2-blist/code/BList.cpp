@@ -11,6 +11,15 @@
  *********************************************************************/
 
 #include "BList.h"
+#include "BListScan.h" // vectorized search within a node
+#include <algorithm>   // std::sort, std::merge, std::push_heap, std::pop_heap
+#include <climits>     // INT_MAX
+#include <cstring>     // std::memcmp, std::memcpy
+#include <future>      // std::async, parallel copy
+#include <istream>     // std::istream
+#include <ostream>     // std::ostream
+#include <thread>      // std::thread::hardware_concurrency
+#include <vector>      // std::vector
 
 template <typename T, unsigned Size>
 size_t BList<T, Size>::nodesize(void)
@@ -24,6 +33,20 @@ const typename BList<T, Size>::BNode *BList<T, Size>::GetHead() const
   return head_;
 }
 
+/**
+ * @brief Returns the slot of the head's first item.
+ *
+ * In deque mode the head's items are values[head_offset(), head_offset() + count)
+ * of the node returned by GetHead; every other node starts at slot 0.
+ *
+ * @return The number of free slots in front of the head's items.
+ */
+template <typename T, unsigned Size>
+int BList<T, Size>::head_offset() const
+{
+  return front_gap_;
+}
+
 /**
  * @brief Default constructor for the BList class.
  *
@@ -35,6 +58,7 @@ const typename BList<T, Size>::BNode *BList<T, Size>::GetHead() const
  */
 template <typename T, unsigned Size>
 BList<T, Size>::BList()
+    : rebalance_(false), deque_(false), front_gap_(0), cursor_node_(nullptr), cursor_start_(0)
 {
   // Initialize head and tail pointers to nullptr
   head_ = nullptr;
@@ -45,63 +69,215 @@ BList<T, Size>::BList()
   stats_.ArraySize = Size;
 }
 
+/**
+ * @brief Constructs a BList that fills only part of each node's array.
+ *
+ * This is a fill limit, not a node size: every node still holds Size slots
+ * (nodesize() is unchanged), but a node counts as full once capacity of them
+ * are in use. It changes how often nodes split and how many items a search
+ * passes per node, not the memory a node occupies. To change the node size,
+ * and so its cache footprint, change Size, e.g. with CacheBList<T, Lines>.
+ *
+ * @param capacity The number of items each node may hold, 1 to Size.
+ * @throws BListException with E_DATA_ERROR if capacity is out of range.
+ */
+template <typename T, unsigned Size>
+BList<T, Size>::BList(int capacity) : BList()
+{
+  if (capacity < 1 || capacity > static_cast<int>(Size))
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_DATA_ERROR, "Node capacity out of range!"};
+
+  stats_.ArraySize = capacity;
+}
+
 /**
  * @brief Copy constructor for BList class.
  *
  * This constructor creates a deep copy of the given BList object.
- * It iterates through the nodes of the given BList and creates new nodes
- * with the same values. The new nodes are then linked together to form
- * a new BList.
+ * The nodes are copied by copyNodes, in parallel for large lists.
  *
  * @param rhs The BList object to be copied.
  */
 template <typename T, unsigned Size>
-BList<T, Size>::BList(const BList &rhs) : stats_{rhs.stats_}
+BList<T, Size>::BList(const BList &rhs)
+    : stats_{rhs.stats_}, rebalance_(rhs.rebalance_), deque_(rhs.deque_), front_gap_(0),
+      cursor_node_(nullptr), cursor_start_(0)
 {
   // Initialize head and tail pointers to nullptr
   head_ = nullptr;
   tail_ = nullptr;
 
-  // Pointer to traverse the rhs list
-  BNode *rhs_current = rhs.head_;
+  copyNodes(rhs);
+}
 
-  // Pointer to keep track of the last node created
-  BNode *last_new_node = nullptr;
+/**
+ * @brief Deep copies the nodes of another BList into this (empty) BList.
+ *
+ * Lists with at least ParallelCopyItems items are copied by copyNodesParallel
+ * when more than one hardware thread is available, smaller lists node by node
+ * on the calling thread.
+ *
+ * @param rhs The BList whose nodes are copied.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::copyNodes(const BList &rhs)
+{
+  if (rhs.stats_.ItemCount >= ParallelCopyItems && std::thread::hardware_concurrency() > 1)
+    copyNodesParallel(rhs);
+  else
+    copyNodesSerial(rhs);
+}
 
-  // Iterate through the rhs list
-  while (rhs_current != nullptr)
+/**
+ * @brief Deep copies the nodes of another BList on the calling thread.
+ *
+ * If a node cannot be created, or copying an item throws, the nodes copied
+ * so far are freed and the exception is passed on, leaving this BList empty.
+ * Each node is linked in before it is filled, so clear() reaches it.
+ *
+ * @param rhs The BList whose nodes are copied.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::copyNodesSerial(const BList &rhs)
+{
+  try
   {
-    // Create a new node
-    BNode *new_node = createNode();
+    // Pointer to traverse the rhs list
+    BNode *rhs_current = rhs.head_;
 
-    // Copy values from the rhs node to the new node
-    for (int i = 0; i < rhs_current->count; ++i)
-    {
-      new_node->values[i] = rhs_current->values[i];
-      new_node->count++;
-    }
+    // Pointer to keep track of the last node created
+    BNode *last_new_node = nullptr;
 
-    // Link the new node with the previous one
-    if (last_new_node != nullptr)
+    // Iterate through the rhs list
+    while (rhs_current != nullptr)
     {
-      last_new_node->next = new_node;
-      new_node->prev = last_new_node;
+      // Create a new node
+      BNode *new_node = createNode();
+
+      // Link the new node with the previous one before filling it, so clear()
+      // frees it if copying an item throws
+      if (last_new_node != nullptr)
+      {
+        last_new_node->next = new_node;
+        new_node->prev = last_new_node;
+      }
+      else
+      {
+        // If last_new_node is nullptr, it means this is the first node
+        head_ = new_node;
+      }
+
+      // Update last_new_node to the newly created node
+      last_new_node = new_node;
+
+      // Copy values from the rhs node to the new node
+      const T *values = rhs_current->values + rhs.firstSlot(rhs_current);
+      for (int i = 0; i < rhs_current->count; ++i)
+      {
+        new_node->values[i] = values[i];
+        new_node->count++;
+      }
+
+      // Move to the next node in the rhs list
+      rhs_current = rhs_current->next;
     }
-    else
+
+    // Update tail_ pointer
+    tail_ = last_new_node;
+  }
+  catch (...)
+  {
+    clear();
+    throw;
+  }
+}
+
+/**
+ * @brief Deep copies the nodes of another BList using several threads.
+ *
+ * All nodes are allocated up front on the calling thread. The nodes are then
+ * split into one contiguous run per thread, and each thread copies the
+ * payloads of its run and links its nodes to their neighbours, which are
+ * already known. No two threads write to the same node.
+ *
+ * If allocation or copying fails, all new nodes are freed after every thread
+ * has finished and the exception is passed on, leaving this BList empty.
+ *
+ * @param rhs The BList whose nodes are copied.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::copyNodesParallel(const BList &rhs)
+{
+  std::vector<const BNode *> source;
+  source.reserve(static_cast<size_t>(rhs.stats_.NodeCount));
+  for (auto node = rhs.head_; node; node = node->next)
+    source.push_back(node);
+  const int head_gap = rhs.front_gap_;
+
+  const size_t node_count = source.size();
+  std::vector<BNode *> nodes(node_count, nullptr);
+  std::vector<std::future<void>> tasks;
+
+  try
+  {
+    for (size_t i = 0; i < node_count; ++i)
+      nodes[i] = createNode();
+
+    size_t threads = std::thread::hardware_concurrency();
+    size_t chunk = (node_count + threads - 1) / threads;
+
+    for (size_t begin = 0; begin < node_count; begin += chunk)
     {
-      // If last_new_node is nullptr, it means this is the first node
-      head_ = new_node;
+      size_t end = begin + chunk < node_count ? begin + chunk : node_count;
+      tasks.push_back(std::async(std::launch::async, [&source, &nodes, node_count, head_gap, begin, end]() {
+        for (size_t i = begin; i < end; ++i)
+        {
+          BNode *node = nodes[i];
+          const T *values = source[i]->values + (i == 0 ? head_gap : 0);
+          for (int j = 0; j < source[i]->count; ++j)
+            node->values[j] = values[j];
+          node->count = source[i]->count;
+          node->prev = i > 0 ? nodes[i - 1] : nullptr;
+          node->next = i + 1 < node_count ? nodes[i + 1] : nullptr;
+        }
+      }));
     }
 
-    // Update last_new_node to the newly created node
-    last_new_node = new_node;
-
-    // Move to the next node in the rhs list
-    rhs_current = rhs_current->next;
+    for (auto &task : tasks)
+      task.get();
+  }
+  catch (...)
+  {
+    for (auto &task : tasks)
+      if (task.valid())
+        task.wait();
+    for (auto node : nodes)
+      delete node;
+    clear();
+    throw;
   }
 
-  // Update tail_ pointer
-  tail_ = last_new_node;
+  head_ = nodes.front();
+  tail_ = nodes.back();
+}
+
+/**
+ * @brief Range constructor for the BList class.
+ *
+ * Builds the list from the items in [first, last) in order, as if by
+ * push_back, but fills each node completely before allocating the next.
+ * Only takes part in overload resolution when InputIt is an iterator, so
+ * BList(3, 5) does not compile rather than reading from two ints.
+ *
+ * @param first The beginning of the range.
+ * @param last The end of the range.
+ */
+template <typename T, unsigned Size>
+template <typename InputIt, typename>
+BList<T, Size>::BList(InputIt first, InputIt last) : BList()
+{
+  append(first, last);
 }
 
 /**
@@ -122,7 +298,8 @@ BList<T, Size>::~BList()
  * @brief Assignment operator overload for BList.
  *
  * This function assigns the contents of the given BList object to the current BList object.
- * It performs a deep copy of the elements from the given BList to the current BList.
+ * It performs a deep copy of the elements from the given BList to the current BList,
+ * in parallel for large lists.
  *
  * @param rhs The BList object to be assigned.
  * @return A reference to the current BList object after assignment.
@@ -137,49 +314,12 @@ BList<T, Size> &BList<T, Size>::operator=(const BList &rhs)
   // Clear the current list
   clear();
 
-  // Copy statistics
+  // Copy statistics and policies
   stats_ = rhs.stats_;
+  rebalance_ = rhs.rebalance_;
+  deque_ = rhs.deque_;
 
-  // Pointer to traverse the rhs list
-  BNode *rhs_current = rhs.head_;
-
-  // Pointer to keep track of the last node created
-  BNode *last_new_node = nullptr;
-
-  // Iterate through the rhs list
-  while (rhs_current != nullptr)
-  {
-    // Create a new node
-    BNode *new_node = createNode();
-
-    // Copy values from the rhs node to the new node
-    for (int i = 0; i < rhs_current->count; ++i)
-    {
-      new_node->values[i] = rhs_current->values[i];
-      new_node->count++;
-    }
-
-    // Link the new node with the previous one
-    if (last_new_node != nullptr)
-    {
-      last_new_node->next = new_node;
-      new_node->prev = last_new_node;
-    }
-    else
-    {
-      // If last_new_node is nullptr, it means this is the first node
-      head_ = new_node;
-    }
-
-    // Update last_new_node to the newly created node
-    last_new_node = new_node;
-
-    // Move to the next node in the rhs list
-    rhs_current = rhs_current->next;
-  }
-
-  // Update tail_ pointer
-  tail_ = last_new_node;
+  copyNodes(rhs);
   return *this;
 }
 
@@ -193,6 +333,9 @@ BList<T, Size> &BList<T, Size>::operator=(const BList &rhs)
 template <typename T, unsigned Size>
 void BList<T, Size>::push_back(const T &value)
 {
+  if (tail_ == head_)
+    normalizeHead();
+
   if (tail_ && tail_->count < stats_.ArraySize)
   {
     addToTail(value);
@@ -206,6 +349,86 @@ void BList<T, Size>::push_back(const T &value)
 }
 
 
+/**
+ * @brief Appends the items in a range to the end of the BList.
+ *
+ * The free slots of the tail node are filled first, then each new node is
+ * filled completely before the next is allocated, so N items need only
+ * ceil(N / Size) new nodes and a single pass over the range.
+ *
+ * @param first The beginning of the range.
+ * @param last The end of the range.
+ */
+template <typename T, unsigned Size>
+template <typename InputIt>
+void BList<T, Size>::append(InputIt first, InputIt last)
+{
+  if (tail_ == head_)
+    normalizeHead();
+
+  while (first != last)
+  {
+    if (!tail_ || tail_->count == stats_.ArraySize)
+      createEmptyNodeAtTail();
+
+    auto node = tail_;
+    auto added = 0;
+    for (; first != last && node->count < stats_.ArraySize; ++first)
+    {
+      node->values[node->count++] = *first;
+      ++added;
+    }
+    stats_.ItemCount += added;
+  }
+}
+
+/**
+ * @brief Replaces the contents of the BList with the items in a range.
+ *
+ * @param first The beginning of the range.
+ * @param last The end of the range.
+ */
+template <typename T, unsigned Size>
+template <typename InputIt>
+void BList<T, Size>::assign(InputIt first, InputIt last)
+{
+  clear();
+  append(first, last);
+}
+
+/**
+ * @brief Replaces the contents of the BList with a sorted range.
+ *
+ * The nodes are packed completely, which is a valid layout for a sorted
+ * list, so later calls to insert keep the list sorted. The range is checked
+ * while loading using only operator<.
+ *
+ * @param first The beginning of the sorted range.
+ * @param last The end of the sorted range.
+ * @throws BListException with E_DATA_ERROR if the range is not sorted.
+ */
+template <typename T, unsigned Size>
+template <typename InputIt>
+void BList<T, Size>::build_from_sorted(InputIt first, InputIt last)
+{
+  assign(first, last);
+
+  const T *previous = nullptr;
+  for (auto node = head_; node; node = node->next)
+  {
+    for (auto i = 0; i < node->count; ++i)
+    {
+      if (previous && node->values[i] < *previous)
+      {
+        clear();
+        throw BListException{
+            BListException::BLIST_EXCEPTION::E_DATA_ERROR, "Range is not sorted!"};
+      }
+      previous = &node->values[i];
+    }
+  }
+}
+
 /**
  * @brief Adds a new element to the tail of the BList.
  * 
@@ -225,10 +448,18 @@ void BList<T, Size>::addToTail(const T &value)
  */
 template <typename T, unsigned Size>
 void BList<T, Size>::createNewNodeAndAddToTail(const T &value)
+{
+  createEmptyNodeAtTail();
+  addToTail(value);
+}
+
+/**
+ * @brief Creates a new empty node and links it after the tail of the BList.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::createEmptyNodeAtTail()
 {
   auto new_node = createNode();
-  new_node->values[0] = value;
-  incrementNode(new_node);
 
   if (stats_.NodeCount == 0)
     tail_ = head_ = new_node;
@@ -241,12 +472,83 @@ void BList<T, Size>::createNewNodeAndAddToTail(const T &value)
   ++stats_.NodeCount;
 }
 
+/**
+ * @brief Links a node after the tail, keeping only its items from first on.
+ *
+ * @param node The unlinked node to reuse.
+ * @param first The index of the first item to keep.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::linkRemainderAtTail(BNode *node, int first)
+{
+  if (first > 0)
+  {
+    for (auto i = first; i < node->count; ++i)
+      node->values[i - first] = node->values[i];
+    node->count -= first;
+  }
+
+  node->next = nullptr;
+  node->prev = tail_;
+  if (tail_)
+    tail_->next = node;
+  else
+    head_ = node;
+  tail_ = node;
+  ++stats_.NodeCount;
+}
+
+/**
+ * @brief Links a chain of unlinked nodes after the tail.
+ *
+ * @param node The first node of the chain, may be nullptr.
+ * @param first The index of the first item to keep in the first node.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::linkChainAtTail(BNode *node, int first)
+{
+  while (node)
+  {
+    auto next = node->next;
+    linkRemainderAtTail(node, first);
+    node = next;
+    first = 0;
+  }
+}
+
+/**
+ * @brief Moves one item of an unlinked node to the tail of the BList.
+ *
+ * A new node is created when the tail is full. The source node is freed once
+ * all of its items have been moved, and (node, index) advances to the next
+ * item to be merged.
+ *
+ * @param node The unlinked node holding the item.
+ * @param index The index of the item within the node.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::moveItemToTail(BNode *&node, int &index)
+{
+  if (!tail_ || tail_->count == stats_.ArraySize)
+    createEmptyNodeAtTail();
+
+  tail_->values[tail_->count++] = node->values[index++];
+  if (index == node->count)
+  {
+    auto next = node->next;
+    delete node;
+    node = next;
+    index = 0;
+  }
+}
+
 /**
  * @brief Inserts a new element at the beginning of the BList.
  *
  * This function inserts a new element with the given value at the beginning of the BList.
  * If the head node has available space, the value is added to the head node.
- * Otherwise, a new node is created and the value is added to it.
+ * Otherwise, a new node is created and the value is added to it. In deque
+ * mode the new node is filled from the back (see set_deque_mode).
  *
  * @param value The value to be inserted.
  * @tparam T The type of the elements in the BList.
@@ -255,7 +557,13 @@ void BList<T, Size>::createNewNodeAndAddToTail(const T &value)
 template <typename T, unsigned Size>
 void BList<T, Size>::push_front(const T &value)
 {
-  if (head_ && head_->count < stats_.ArraySize)
+  invalidateCursor();
+  if (front_gap_)
+  {
+    head_->values[--front_gap_] = value;
+    ++head_->count;
+  }
+  else if (head_ && head_->count < stats_.ArraySize)
   {
     addToHead(value);
   }
@@ -290,7 +598,14 @@ template <typename T, unsigned Size>
 void BList<T, Size>::createNewNodeAndAddToHead(const T &value)
 {
   auto new_node = createNode();
-  new_node->values[0] = value;
+  if (deque_)
+  {
+    // Fill from the back so the following front pushes need no shifting
+    front_gap_ = stats_.ArraySize - 1;
+    new_node->values[front_gap_] = value;
+  }
+  else
+    new_node->values[0] = value;
   incrementNode(new_node);
 
   if (stats_.NodeCount == 0)
@@ -316,6 +631,7 @@ void BList<T, Size>::createNewNodeAndAddToHead(const T &value)
 template <typename T, unsigned Size>
 void BList<T, Size>::insert(const T &value)
 {
+  invalidateCursor();
   if (!head_)
   {
     push_front(value);
@@ -336,27 +652,22 @@ void BList<T, Size>::insert(const T &value)
 
 /**
  * @brief Finds the node in the BList to insert the given value.
- * 
+ *
+ * The nodes are sorted, so a node whose last item is less than the value
+ * holds nothing that is not, and is skipped after that one compare.
+ *
  * @param value The value to be inserted.
- * @return A pointer to the BNode where the value should be inserted.
+ * @return A pointer to the first BNode holding an item not less than the
+ *         value, or nullptr if the value goes after every item.
  */
 template <typename T, unsigned Size>
 typename BList<T, Size>::BNode* BList<T, Size>::findNodeToInsert(const T &value)
 {
+  normalizeHead();
   auto current = head_;
-  auto i = 0;
-  
-  while (current)
-  {
-    while (i < stats_.ArraySize && current->values[i] < value)
-      ++i;
-
-    if (i < current->count)
-      break;
 
-    i = 0;
+  while (current && (!current->count || current->values[current->count - 1] < value))
     current = current->next;
-  }
 
   return current;
 }
@@ -409,6 +720,9 @@ void BList<T, Size>::insertValueIntoNode(const T &value, BNode* node)
 
 /**
  * @brief Finds the insertion index for a given value in a BNode.
+ *
+ * Binary search over the node's live items, so the index is the first
+ * item not less than the value, as with a linear scan.
  * 
  * @param value The value to be inserted.
  * @param node The BNode in which the value will be inserted.
@@ -417,10 +731,17 @@ void BList<T, Size>::insertValueIntoNode(const T &value, BNode* node)
 template <typename T, unsigned Size>
 int BList<T, Size>::findInsertionIndex(const T &value, BNode* node)
 {
-  auto i = 0;
-  while (i < node->count && node->values[i] < value)
-    ++i;
-  return i;
+  auto low = 0;
+  auto high = node->count;
+  while (low < high)
+  {
+    auto mid = low + (high - low) / 2;
+    if (node->values[mid] < value)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return low;
 }
 
 /**
@@ -453,27 +774,20 @@ void BList<T, Size>::insertValueAtTail(const T &value)
  * If the node becomes empty after the removal, it is freed.
  *
  * @param index The index of the element to be removed.
+ * @throws BListException with E_BAD_INDEX if the index is out of range.
  * @tparam T The type of elements stored in the BList.
  * @tparam Size The maximum number of elements that can be stored in each node.
  */
 template <typename T, unsigned Size>
 void BList<T, Size>::remove(int index)
 {
-  auto current = head_;
-  auto total_index = current->count;
-  auto i = index;
-
-  while (total_index <= index)
-  {
-    i -= current->count;
-    current = current->next;
-    if (current)
-      total_index += current->count;
-  }
+  normalizeHead();
+  auto i = 0;
+  auto current = findNodeContainingIndex(index, i);
 
+  invalidateCursor();
   removeAtIndex(current, i);
-  if (current->count == 0)
-    freeNode(current);
+  handleUnderflow(current, i);
 }
 
 /**
@@ -486,21 +800,18 @@ void BList<T, Size>::remove(int index)
 template <typename T, unsigned Size>
 void BList<T, Size>::remove_by_value(const T &value)
 {
+  invalidateCursor();
+  normalizeHead();
   auto current = head_;
-  auto total_index = 0;
   while (current)
   {
-    for (auto i = 0; i < current->count; ++i)
+    auto i = BListScan::find(current->values, current->count, value);
+    if (i >= 0)
     {
-      if (current->values[i] == value)
-      {
-        removeAtIndex(current, i);
-        if (current->count == 0)
-          freeNode(current);
-        return;
-      }
+      removeAtIndex(current, i);
+      handleUnderflow(current, i);
+      return;
     }
-    total_index += current->count;
     current = current->next;
   }
 }
@@ -508,6 +819,9 @@ void BList<T, Size>::remove_by_value(const T &value)
 /**
  * @brief Finds the index of the first occurrence of the specified value in the BList.
  *
+ * Each node's array is searched with BListScan::find, which compares several
+ * items per instruction for integral and floating-point types.
+ *
  * @tparam T The type of elements stored in the BList.
  * @tparam Size The maximum number of elements that can be stored in each BNode.
  * @param value The value to search for.
@@ -520,11 +834,9 @@ int BList<T, Size>::find(const T &value) const
   auto total_index = 0;
   while (current)
   {
-    for (auto i = 0; i < current->count; ++i)
-    {
-      if (current->values[i] == value)
-        return total_index + i;
-    }
+    auto i = BListScan::find(current->values + firstSlot(current), current->count, value);
+    if (i >= 0)
+      return total_index + i;
     total_index += current->count;
     current = current->next;
   }
@@ -532,90 +844,1069 @@ int BList<T, Size>::find(const T &value) const
 }
 
 /**
- * @brief Returns a reference to the element at the specified index in the BList.
+ * @brief Returns the first item in the BList, in O(1).
  *
- * @param index The index of the element to access.
- * @return A reference to the element at the specified index.
+ * @return A reference to the first item.
+ * @throws BListException with E_BAD_INDEX if the list is empty.
  */
 template <typename T, unsigned Size>
-T &BList<T, Size>::operator[](int index)
+T &BList<T, Size>::front()
 {
-  return valueAtIndex(index);
+  if (!head_)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_BAD_INDEX, "List is empty!"};
+  return head_->values[front_gap_];
 }
 
 /**
- * @brief Overloaded subscript operator for accessing elements in the BList.
+ * @brief Returns the first item in the BList, in O(1).
  *
- * @tparam T The type of elements stored in the BList.
- * @tparam Size The maximum number of elements that can be stored in the BList.
- * @param index The index of the element to access.
- * @return const T& A reference to the element at the specified index.
+ * @return A const reference to the first item.
+ * @throws BListException with E_BAD_INDEX if the list is empty.
  */
 template <typename T, unsigned Size>
-const T &BList<T, Size>::operator[](int index) const
+const T &BList<T, Size>::front() const
 {
-  return valueAtIndex(index);
+  if (!head_)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_BAD_INDEX, "List is empty!"};
+  return head_->values[front_gap_];
 }
 
 /**
- * @brief Returns the number of items in the BList.
+ * @brief Returns the last item in the BList, in O(1).
  *
- * @return The number of items in the BList.
+ * @return A reference to the last item.
+ * @throws BListException with E_BAD_INDEX if the list is empty.
  */
 template <typename T, unsigned Size>
-size_t BList<T, Size>::size() const
+T &BList<T, Size>::back()
 {
-  return stats_.ItemCount;
+  if (!tail_)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_BAD_INDEX, "List is empty!"};
+  return tail_->values[(tail_ == head_ ? front_gap_ : 0) + tail_->count - 1];
 }
 
 /**
- * @brief Clears the BList by removing all items.
+ * @brief Returns the last item in the BList, in O(1).
  *
- * This function removes all items from the BList by repeatedly calling the remove() function
- * until the number of items in the BList becomes zero.
- *
- * @tparam T The type of elements stored in the BList.
- * @tparam Size The maximum number of elements that the BList can hold.
+ * @return A const reference to the last item.
+ * @throws BListException with E_BAD_INDEX if the list is empty.
  */
 template <typename T, unsigned Size>
-void BList<T, Size>::clear()
+const T &BList<T, Size>::back() const
 {
-  while (stats_.ItemCount > 0)
-    remove(0);
+  if (!tail_)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_BAD_INDEX, "List is empty!"};
+  return tail_->values[(tail_ == head_ ? front_gap_ : 0) + tail_->count - 1];
 }
 
 /**
- * @brief Get the statistics of the BList.
+ * @brief Removes the first item in the BList.
  *
- * @tparam T The type of elements stored in the BList.
- * @tparam Size The maximum number of elements that the BList can hold.
- * @return BListStats The statistics of the BList.
+ * Only the head node is touched (its items shift down by one), so the cost
+ * does not depend on the length of the list. In deque mode, without
+ * rebalancing, the freed slot just joins the gap in front of the head's
+ * items, so nothing is shifted.
+ *
+ * @throws BListException with E_BAD_INDEX if the list is empty.
  */
 template <typename T, unsigned Size>
-BListStats BList<T, Size>::GetStats() const
+void BList<T, Size>::pop_front()
 {
-  return stats_;
+  if (!head_)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_BAD_INDEX, "List is empty!"};
+
+  invalidateCursor();
+  if (deque_ && !rebalance_ && head_->count > 1)
+  {
+    ++front_gap_;
+    --head_->count;
+    --stats_.ItemCount;
+    return;
+  }
+
+  normalizeHead();
+  auto node = head_;
+  auto index = 0;
+  removeAtIndex(node, index);
+  handleUnderflow(node, index);
 }
 
 /**
- * @brief Creates a new BNode object.
+ * @brief Removes the last item in the BList, in O(1).
  *
- * This function creates a new BNode object by allocating memory and copying the values from the given BNode object.
- * If the given BNode object is null, the new BNode object will be initialized with default values.
- *
- * @param rhs The BNode object to copy values from.
- * @return A pointer to the newly created BNode object.
- * @throws BListException if there is not enough memory to create the new BNode object.
+ * @throws BListException with E_BAD_INDEX if the list is empty.
  */
 template <typename T, unsigned Size>
-typename BList<T, Size>::BNode *BList<T, Size>::createNode(const BNode *rhs)
+void BList<T, Size>::pop_back()
 {
-  auto new_node = new (std::nothrow) BNode;
-  if (!new_node)
+  if (!tail_)
     throw BListException{
-        BListException::BLIST_EXCEPTION::E_NO_MEMORY, "Not enough memory to create a new node!"};
+        BListException::BLIST_EXCEPTION::E_BAD_INDEX, "List is empty!"};
+
+  invalidateCursor();
+  if (tail_ == head_ || rebalance_)
+    normalizeHead();
+  auto node = tail_;
+  auto index = tail_->count - 1;
+  removeAtIndex(node, index);
+  handleUnderflow(node, index);
+}
 
-  if (rhs)
+/**
+ * @brief Returns a reference to the element at the specified index in the BList.
+ *
+ * The lookup cursor is moved to the node found, so sequential and nearby
+ * accesses through a non-const BList take amortized O(1).
+ *
+ * @param index The index of the element to access.
+ * @return A reference to the element at the specified index.
+ * @throws BListException with E_BAD_INDEX if the index is out of range.
+ */
+template <typename T, unsigned Size>
+T &BList<T, Size>::operator[](int index)
+{
+  auto relative = 0;
+  auto current = findNodeContainingIndex(index, relative);
+
+  cursor_node_ = current;
+  cursor_start_ = index - (relative - firstSlot(current));
+  return current->values[relative];
+}
+
+/**
+ * @brief Overloaded subscript operator for accessing elements in the BList.
+ *
+ * The lookup starts from the cursor left by the last non-const lookup but
+ * does not move it, so a const BList is never written to and may be read
+ * by several threads at once.
+ *
+ * @tparam T The type of elements stored in the BList.
+ * @tparam Size The maximum number of elements that can be stored in the BList.
+ * @param index The index of the element to access.
+ * @return const T& A reference to the element at the specified index.
+ */
+template <typename T, unsigned Size>
+const T &BList<T, Size>::operator[](int index) const
+{
+  return valueAtIndex(index);
+}
+
+/**
+ * @brief Returns the number of items in the BList.
+ *
+ * @return The number of items in the BList.
+ */
+template <typename T, unsigned Size>
+size_t BList<T, Size>::size() const
+{
+  return stats_.ItemCount;
+}
+
+/**
+ * @brief Clears the BList by removing all items.
+ *
+ * This function frees every node in the list directly rather than removing
+ * items one at a time, so no shifting or rebalancing is done.
+ *
+ * @tparam T The type of elements stored in the BList.
+ * @tparam Size The maximum number of elements that the BList can hold.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::clear()
+{
+  invalidateCursor();
+  auto current = head_;
+  while (current)
+  {
+    auto next = current->next;
+    delete current;
+    current = next;
+  }
+
+  head_ = tail_ = nullptr;
+  front_gap_ = 0;
+  stats_.NodeCount = 0;
+  stats_.ItemCount = 0;
+}
+
+/**
+ * @brief Enables or disables rebalancing of under-full nodes on removal.
+ *
+ * When enabled, a node that drops below half full after a removal borrows an
+ * item from a neighbour that can spare one, or is merged with a neighbour,
+ * in the same way a B-tree handles underflow. When disabled (the default),
+ * a node is only freed once it is empty.
+ *
+ * @param enable true to rebalance on removal, false for the default policy.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::set_rebalance(bool enable)
+{
+  rebalance_ = enable;
+}
+
+/**
+ * @brief Returns whether under-full nodes are rebalanced on removal.
+ *
+ * @return true if rebalancing is enabled.
+ */
+template <typename T, unsigned Size>
+bool BList<T, Size>::rebalancing() const
+{
+  return rebalance_;
+}
+
+/**
+ * @brief Enables or disables deque mode.
+ *
+ * By default a full head node gets a new node in front of it holding one
+ * item at slot 0, and every further push_front shifts that node's items up.
+ * In deque mode the new head is filled from the back, like a ring buffer,
+ * so pushes and pops at either end are O(1) and the head is as dense as the
+ * tail. Read-only operations (iterators, find, operator[], copying, save)
+ * skip the gap where they stand; operations that move items between slots
+ * first move the head's items back to slot 0. GetHead shows the head as
+ * it is, with its first item at values[head_offset()].
+ * As in the default mode, push_front and pop_front invalidate iterators
+ * into the head node.
+ *
+ * @param enable true for deque mode, false for the default policy.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::set_deque_mode(bool enable)
+{
+  if (!enable)
+    normalizeHead();
+  deque_ = enable;
+}
+
+/**
+ * @brief Returns whether the head node fills from the back on push_front.
+ *
+ * @return true if deque mode is enabled.
+ */
+template <typename T, unsigned Size>
+bool BList<T, Size>::deque_mode() const
+{
+  return deque_;
+}
+
+/**
+ * @brief Moves all items of another BList to the end of this BList.
+ *
+ * The node chain of other is linked after the tail in O(1); no items are
+ * copied and other is left empty.
+ *
+ * @param other The BList to take the items from.
+ * @throws BListException with E_DATA_ERROR if other's nodes may hold more
+ *         items than this BList's node capacity.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::splice(BList &other)
+{
+  other.invalidateCursor();
+  if (this == &other || !other.head_)
+    return;
+
+  other.normalizeHead();
+  if (other.stats_.ArraySize > stats_.ArraySize)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_DATA_ERROR, "Node capacity mismatch!"};
+
+  if (tail_)
+  {
+    tail_->next = other.head_;
+    other.head_->prev = tail_;
+  }
+  else
+    head_ = other.head_;
+  tail_ = other.tail_;
+
+  stats_.NodeCount += other.stats_.NodeCount;
+  stats_.ItemCount += other.stats_.ItemCount;
+
+  other.head_ = other.tail_ = nullptr;
+  other.stats_.NodeCount = 0;
+  other.stats_.ItemCount = 0;
+}
+
+/**
+ * @brief Splits the BList in two at an index.
+ *
+ * The items from index to the end are moved into rest, replacing its
+ * contents. If index falls on a node boundary the nodes are just relinked,
+ * otherwise the node containing index is split and only its upper part is
+ * copied, so the cost is O(nodes) rather than O(items).
+ *
+ * @param index The index of the first item to move; size() moves nothing.
+ * @param rest The BList receiving the items (must not be this BList).
+ * @throws BListException with E_BAD_INDEX if index is out of range.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::split_at(int index, BList &rest)
+{
+  invalidateCursor();
+  if (index < 0 || index > stats_.ItemCount)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_BAD_INDEX, "Index out of range!"};
+
+  if (&rest == this)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_DATA_ERROR, "Cannot split into the same list!"};
+
+  rest.clear();
+  rest.stats_.ArraySize = stats_.ArraySize;
+  if (index == stats_.ItemCount)
+    return;
+
+  normalizeHead();
+  // Find the node holding index and the position within it
+  auto node = head_;
+  auto relative = index;
+  while (relative >= node->count)
+  {
+    relative -= node->count;
+    node = node->next;
+  }
+
+  auto first = node;
+  if (relative > 0)
+  {
+    first = createNode();
+    for (auto i = relative; i < node->count; ++i)
+      first->values[first->count++] = node->values[i];
+    node->count = relative;
+    setupNewNode(node, first);
+    updateTailIfNeeded(node, first);
+    ++stats_.NodeCount;
+  }
+
+  auto moved_nodes = 0;
+  for (auto current = first; current; current = current->next)
+    ++moved_nodes;
+
+  rest.head_ = first;
+  rest.tail_ = tail_;
+  rest.stats_.NodeCount = moved_nodes;
+  rest.stats_.ItemCount = stats_.ItemCount - index;
+
+  tail_ = first->prev;
+  first->prev = nullptr;
+  if (tail_)
+    tail_->next = nullptr;
+  else
+    head_ = nullptr;
+
+  stats_.NodeCount -= moved_nodes;
+  stats_.ItemCount = index;
+}
+
+/**
+ * @brief Merges another sorted BList into this sorted BList.
+ *
+ * Whenever the remaining items of a node all belong before the next item of
+ * the other list, the node is moved into the result as is (after shifting
+ * out items already merged). Otherwise items are moved one at a time into
+ * packed nodes and emptied source nodes are freed. Equal items from this
+ * list come before those from other. other is left empty.
+ *
+ * If a node cannot be allocated, the unmerged items are appended unsorted
+ * so that no item is lost, and the exception is passed on.
+ *
+ * @param other The sorted BList to merge from.
+ * @throws BListException with E_DATA_ERROR if other's nodes may hold more
+ *         items than this BList's node capacity.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::merge(BList &other)
+{
+  invalidateCursor();
+  other.invalidateCursor();
+  if (this == &other || !other.head_)
+    return;
+
+  if (other.stats_.ArraySize > stats_.ArraySize)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_DATA_ERROR, "Node capacity mismatch!"};
+
+  normalizeHead();
+  other.normalizeHead();
+  auto a = head_;
+  auto b = other.head_;
+  auto ai = 0;
+  auto bi = 0;
+  auto items = stats_.ItemCount + other.stats_.ItemCount;
+
+  // Rebuild this list from the two chains
+  head_ = tail_ = nullptr;
+  stats_.NodeCount = 0;
+  other.head_ = other.tail_ = nullptr;
+  other.stats_.NodeCount = 0;
+  other.stats_.ItemCount = 0;
+
+  try
+  {
+    while (a && b)
+    {
+      if (!(b->values[bi] < a->values[a->count - 1]))
+      {
+        auto next = a->next;
+        linkRemainderAtTail(a, ai);
+        a = next;
+        ai = 0;
+      }
+      else if (b->values[b->count - 1] < a->values[ai])
+      {
+        auto next = b->next;
+        linkRemainderAtTail(b, bi);
+        b = next;
+        bi = 0;
+      }
+      else if (b->values[bi] < a->values[ai])
+        moveItemToTail(b, bi);
+      else
+        moveItemToTail(a, ai);
+    }
+  }
+  catch (...)
+  {
+    linkChainAtTail(a, ai);
+    linkChainAtTail(b, bi);
+    stats_.ItemCount = items;
+    throw;
+  }
+
+  linkChainAtTail(a, ai);
+  linkChainAtTail(b, bi);
+  stats_.ItemCount = items;
+}
+
+/**
+ * @brief Sorts the items of the BList.
+ *
+ * Each node's array is sorted on its own and the sorted nodes are then
+ * k-way merged into new, completely packed nodes. Lists of at least
+ * ParallelSortItems items are sorted by sortNodesParallel instead when more
+ * than one hardware thread is available. This is O(N log N) overall,
+ * against O(N^2 / Size) for inserting every item again, and leaves the
+ * same layout as build_from_sorted, so later calls to insert keep the list
+ * sorted. Equal items may change their relative order.
+ *
+ * If a node cannot be allocated, the list keeps all of its items (possibly
+ * with each node sorted on its own) and the exception is passed on.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::sort()
+{
+  invalidateCursor();
+  normalizeHead();
+
+  std::vector<BNode *> nodes;
+  nodes.reserve(static_cast<size_t>(stats_.NodeCount));
+  for (auto node = head_; node; node = node->next)
+    nodes.push_back(node);
+
+  if (nodes.empty())
+    return;
+
+  if (stats_.ItemCount >= ParallelSortItems && std::thread::hardware_concurrency() > 1 &&
+      nodes.size() > 1)
+  {
+    sortNodesParallel(nodes.data(), nodes.size());
+    return;
+  }
+
+  sortEachNode(nodes.data(), nodes.size());
+  if (nodes.size() > 1)
+    mergeSortedNodes(nodes.data(), nodes.size());
+}
+
+/**
+ * @brief Get the statistics of the BList.
+ *
+ * @tparam T The type of elements stored in the BList.
+ * @tparam Size The maximum number of elements that the BList can hold.
+ * @return BListStats The statistics of the BList.
+ */
+template <typename T, unsigned Size>
+BListStats BList<T, Size>::GetStats() const
+{
+  return stats_;
+}
+
+/**
+ * @brief Returns the number of items each node may hold.
+ *
+ * @return The fill limit, Size unless a smaller one was given at construction.
+ */
+template <typename T, unsigned Size>
+int BList<T, Size>::capacity() const
+{
+  return stats_.ArraySize;
+}
+
+/**
+ * @brief Writes the items of the BList to a stream as a binary image.
+ *
+ * The image is a BListImageHeader followed by the items of every node as a
+ * single contiguous array, one write per node. It can be read back with
+ * load, or used in place (for example from a memory-mapped file) through
+ * BListView.
+ *
+ * @param out The binary stream to write to.
+ * @throws BListException with E_DATA_ERROR if the stream fails.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::save(std::ostream &out) const
+{
+  static_assert(std::is_trivially_copyable<T>::value, "BList::save requires a trivially copyable T");
+
+  BListImageHeader header;
+  std::memcpy(header.Magic, "BLST", sizeof(header.Magic));
+  header.Version = 1;
+  header.ItemSize = sizeof(T);
+  header.ArraySize = static_cast<std::uint32_t>(stats_.ArraySize);
+  header.ItemCount = static_cast<std::uint64_t>(stats_.ItemCount);
+
+  const char padding[alignof(T) > 1 ? alignof(T) : 1] = {};
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(padding, static_cast<std::streamsize>(BListImageHeader::DataOffset(alignof(T)) - sizeof(header)));
+
+  for (auto node = head_; node; node = node->next)
+    out.write(reinterpret_cast<const char *>(node->values + firstSlot(node)), static_cast<std::streamsize>(node->count * sizeof(T)));
+
+  if (!out)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_DATA_ERROR, "Failed to write the list!"};
+}
+
+/**
+ * @brief Replaces the contents of the BList with an image written by save.
+ *
+ * Each node is filled completely by a single read straight into its array,
+ * so there is no per-item push_back. The node size of the writer does not
+ * need to match this BList.
+ *
+ * @param in The binary stream to read from.
+ * @throws BListException with E_DATA_ERROR if the image is malformed, was
+ *         written for a different item size, or is truncated. The BList is
+ *         left empty in that case.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::load(std::istream &in)
+{
+  static_assert(std::is_trivially_copyable<T>::value, "BList::load requires a trivially copyable T");
+
+  clear();
+
+  BListImageHeader header;
+  in.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!in || std::memcmp(header.Magic, "BLST", sizeof(header.Magic)) != 0 || header.Version != 1 ||
+      header.ItemSize != sizeof(T) || header.ItemCount > static_cast<std::uint64_t>(INT_MAX))
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_DATA_ERROR, "Not a BList image for this type!"};
+
+  in.ignore(static_cast<std::streamsize>(BListImageHeader::DataOffset(alignof(T)) - sizeof(header)));
+
+  auto remaining = static_cast<int>(header.ItemCount);
+  while (remaining > 0)
+  {
+    createEmptyNodeAtTail();
+    auto count = remaining < stats_.ArraySize ? remaining : stats_.ArraySize;
+    in.read(reinterpret_cast<char *>(tail_->values), static_cast<std::streamsize>(count * sizeof(T)));
+    if (!in)
+    {
+      clear();
+      throw BListException{
+          BListException::BLIST_EXCEPTION::E_DATA_ERROR, "BList image is truncated!"};
+    }
+
+    tail_->count = count;
+    stats_.ItemCount += count;
+    remaining -= count;
+  }
+}
+
+/**
+ * @brief Returns an iterator to the first item in the BList.
+ *
+ * @return An iterator to the first item, or end() if the list is empty.
+ */
+template <typename T, unsigned Size>
+typename BList<T, Size>::iterator BList<T, Size>::begin()
+{
+  return iterator(head_, front_gap_, this);
+}
+
+/**
+ * @brief Returns an iterator one past the last item in the BList.
+ *
+ * @return The end iterator.
+ */
+template <typename T, unsigned Size>
+typename BList<T, Size>::iterator BList<T, Size>::end()
+{
+  return iterator(nullptr, 0, this);
+}
+
+/**
+ * @brief Returns a read-only iterator to the first item in the BList.
+ *
+ * @return A const_iterator to the first item, or end() if the list is empty.
+ */
+template <typename T, unsigned Size>
+typename BList<T, Size>::const_iterator BList<T, Size>::begin() const
+{
+  return const_iterator(head_, front_gap_, this);
+}
+
+/**
+ * @brief Returns a read-only iterator one past the last item in the BList.
+ *
+ * @return The end const_iterator.
+ */
+template <typename T, unsigned Size>
+typename BList<T, Size>::const_iterator BList<T, Size>::end() const
+{
+  return const_iterator(nullptr, 0, this);
+}
+
+/**
+ * @brief Returns a read-only iterator to the first item in the BList.
+ *
+ * @return A const_iterator to the first item, or cend() if the list is empty.
+ */
+template <typename T, unsigned Size>
+typename BList<T, Size>::const_iterator BList<T, Size>::cbegin() const
+{
+  return begin();
+}
+
+/**
+ * @brief Returns a read-only iterator one past the last item in the BList.
+ *
+ * @return The end const_iterator.
+ */
+template <typename T, unsigned Size>
+typename BList<T, Size>::const_iterator BList<T, Size>::cend() const
+{
+  return end();
+}
+
+/**
+ * @brief Inserts a value before the item referred to by an iterator.
+ *
+ * The node at the position is used if it has room. A full node first tries to
+ * give the value to the end of the previous node (when inserting at slot 0),
+ * and is otherwise split the same way the sorted insert splits nodes.
+ * Inserting at end() appends to the tail like push_back.
+ * Iterators to the affected node(s) are invalidated, and in deque mode
+ * iterators into the head node as well, since its items move back to slot 0.
+ *
+ * @param position The item before which the value is inserted.
+ * @param value The value to be inserted.
+ * @return An iterator to the inserted value.
+ */
+template <typename T, unsigned Size>
+typename BList<T, Size>::iterator BList<T, Size>::insert(const_iterator position, const T &value)
+{
+  invalidateCursor();
+  auto node = const_cast<BNode *>(position.node_);
+  auto index = node ? position.index_ - firstSlot(node) : 0;
+  normalizeHead();
+
+  if (!node)
+  {
+    push_back(value);
+    return iterator(tail_, tail_->count - 1, this);
+  }
+
+  if (node->count < stats_.ArraySize)
+  {
+    insertAtIndex(node, index, value);
+    return iterator(node, index, this);
+  }
+
+  if (index == 0 && node->prev && node->prev->count < stats_.ArraySize)
+  {
+    auto prev = node->prev;
+    insertAtIndex(prev, prev->count, value);
+    return iterator(prev, prev->count - 1, this);
+  }
+
+  splitNode(node, index, value);
+
+  // Work out where splitNode placed the value
+  if (stats_.ArraySize == 1)
+    return index == 0 ? iterator(node, 0, this) : iterator(node->next, 0, this);
+
+  auto middle = stats_.ArraySize / 2;
+  if (index <= middle)
+    return iterator(node, index, this);
+  return iterator(node->next, index - middle, this);
+}
+
+/**
+ * @brief Removes the item referred to by an iterator.
+ *
+ * The node is freed or rebalanced afterwards, as with remove().
+ * Iterators to the affected node(s) are invalidated, and in deque mode
+ * iterators into the head node as well.
+ *
+ * @param position The item to be removed (must not be end()).
+ * @return An iterator to the item that followed the removed one.
+ */
+template <typename T, unsigned Size>
+typename BList<T, Size>::iterator BList<T, Size>::erase(const_iterator position)
+{
+  invalidateCursor();
+  auto node = const_cast<BNode *>(position.node_);
+  auto index = position.index_ - firstSlot(node);
+  normalizeHead();
+
+  removeAtIndex(node, index);
+  handleUnderflow(node, index);
+
+  if (node && index >= node->count)
+  {
+    node = node->next;
+    index = 0;
+  }
+  return iterator(node, index, this);
+}
+
+/**
+ * @brief Sorts the array of every node on its own.
+ *
+ * @param nodes The nodes of the list, in order.
+ * @param count The number of nodes.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::sortEachNode(BNode *const *nodes, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+    std::sort(nodes[i]->values, nodes[i]->values + nodes[i]->count);
+}
+
+/**
+ * @brief Calls work(begin, end) for contiguous chunks of [0, count) on
+ *        separate threads.
+ *
+ * Every thread is waited for before an exception from work is passed on,
+ * so nothing work refers to is destroyed while a thread still uses it.
+ *
+ * @param count The number of things to split.
+ * @param chunks The number of chunks (threads) to split them into.
+ * @param work The function to call for each chunk.
+ */
+template <typename T, unsigned Size>
+template <typename Work>
+void BList<T, Size>::forEachChunk(size_t count, size_t chunks, const Work &work)
+{
+  size_t chunk = (count + chunks - 1) / chunks;
+  std::vector<std::future<void>> tasks;
+  try
+  {
+    for (size_t begin = 0; begin < count; begin += chunk)
+    {
+      size_t end = begin + chunk < count ? begin + chunk : count;
+      tasks.push_back(std::async(std::launch::async, [&work, begin, end]() { work(begin, end); }));
+    }
+
+    for (auto &task : tasks)
+      task.get();
+  }
+  catch (...)
+  {
+    for (auto &task : tasks)
+      if (task.valid())
+        task.wait();
+    throw;
+  }
+}
+
+/**
+ * @brief Returns how many of the first diagonal items of the stable merge of
+ *        two sorted ranges come from the first range.
+ *
+ * This is the split point of a merge path: merging a[0, i) with
+ * b[0, diagonal - i) gives exactly the first diagonal items of the whole
+ * merge, so the merge can be cut into pieces that are done independently.
+ * Equal items of a come before those of b, as with std::merge.
+ *
+ * @param a The first sorted range.
+ * @param a_count The number of items in a.
+ * @param b The second sorted range.
+ * @param b_count The number of items in b.
+ * @param diagonal The number of merged items, at most a_count + b_count.
+ * @return The number of items taken from a.
+ */
+template <typename T, unsigned Size>
+size_t BList<T, Size>::mergeSplit(const T *a, size_t a_count, const T *b, size_t b_count,
+                                  size_t diagonal)
+{
+  size_t low = diagonal > b_count ? diagonal - b_count : 0;
+  size_t high = diagonal < a_count ? diagonal : a_count;
+  while (low < high)
+  {
+    size_t i = low + (high - low) / 2;
+    if (b[diagonal - i - 1] < a[i])
+      high = i;
+    else
+      low = i + 1;
+  }
+  return low;
+}
+
+/**
+ * @brief Sorts the items of the BList into new packed nodes using several
+ *        threads.
+ *
+ * The nodes are split into one contiguous run per hardware thread. Each
+ * thread copies the items of its run into a buffer and sorts them there.
+ * The sorted runs are then merged in pairs, log2(threads) rounds in all,
+ * and every merge is cut along its merge path (see mergeSplit) so that all
+ * threads have an equal share of every round, the last one included.
+ * Finally each thread moves its share of the result into new nodes, which
+ * are filled completely, and the old nodes are freed.
+ *
+ * The old nodes are only read, so if a node cannot be allocated or an item
+ * throws, the list is unchanged and the exception is passed on.
+ *
+ * @param nodes The nodes of the list, in order.
+ * @param count The number of nodes.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::sortNodesParallel(BNode *const *nodes, size_t count)
+{
+  const size_t items = static_cast<size_t>(stats_.ItemCount);
+  size_t threads = std::thread::hardware_concurrency();
+  if (threads > count)
+    threads = count;
+
+  // Item offset of the first node of every run, and of the end
+  size_t chunk = (count + threads - 1) / threads;
+  std::vector<size_t> runs;
+  size_t offset = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (i % chunk == 0)
+      runs.push_back(offset);
+    offset += static_cast<size_t>(nodes[i]->count);
+  }
+  runs.push_back(offset);
+
+  std::vector<T> sorted(items);
+  std::vector<T> merged(items);
+
+  // Copy and sort the runs of nodes
+  T *buffer = sorted.data();
+  forEachChunk(count, threads, [nodes, buffer, &runs, chunk](size_t begin, size_t end) {
+    T *out = buffer + runs[begin / chunk];
+    for (size_t i = begin; i < end; ++i)
+      out = std::copy(nodes[i]->values, nodes[i]->values + nodes[i]->count, out);
+    std::sort(buffer + runs[begin / chunk], out);
+  });
+
+  // Merge pairs of runs, every merge cut into pieces of about items / threads
+  struct Piece
+  {
+    T *a, *a_end; //!< items of the first run to merge
+    T *b, *b_end; //!< items of the second run to merge
+    T *out;       //!< where the merged items go
+  };
+
+  while (runs.size() > 2)
+  {
+    T *from = sorted.data();
+    T *to = merged.data();
+    std::vector<Piece> pieces;
+    std::vector<size_t> next_runs;
+    for (size_t r = 0; r + 1 < runs.size(); r += 2)
+    {
+      next_runs.push_back(runs[r]);
+      T *a = from + runs[r];
+      size_t a_count = runs[r + 1] - runs[r];
+
+      // An odd run out is just moved over
+      if (r + 2 == runs.size())
+      {
+        pieces.push_back(Piece{a, a + a_count, a + a_count, a + a_count, to + runs[r]});
+        continue;
+      }
+
+      T *b = from + runs[r + 1];
+      size_t b_count = runs[r + 2] - runs[r + 1];
+      size_t total = a_count + b_count;
+      size_t parts = (total * threads + items - 1) / items;
+      size_t a_done = 0;
+      for (size_t p = 1; p <= parts; ++p)
+      {
+        size_t diagonal = total * p / parts;
+        size_t a_split = mergeSplit(a, a_count, b, b_count, diagonal);
+        size_t b_done = total * (p - 1) / parts - a_done;
+        pieces.push_back(Piece{a + a_done, a + a_split, b + b_done, b + (diagonal - a_split),
+                               to + runs[r] + a_done + b_done});
+        a_done = a_split;
+      }
+    }
+    next_runs.push_back(items);
+
+    forEachChunk(pieces.size(), threads, [&pieces](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i)
+        std::merge(std::make_move_iterator(pieces[i].a), std::make_move_iterator(pieces[i].a_end),
+                   std::make_move_iterator(pieces[i].b), std::make_move_iterator(pieces[i].b_end),
+                   pieces[i].out);
+    });
+
+    sorted.swap(merged);
+    runs.swap(next_runs);
+  }
+
+  // Move the result into new packed nodes
+  std::vector<BNode *> result;
+  const size_t array_size = static_cast<size_t>(stats_.ArraySize);
+  const size_t out_count = (items + array_size - 1) / array_size;
+  result.reserve(out_count);
+  try
+  {
+    for (size_t i = 0; i < out_count; ++i)
+      result.push_back(createNode());
+
+    T *source = sorted.data();
+    BNode **out = result.data();
+    forEachChunk(out_count, threads, [source, out, out_count, items, array_size](size_t begin,
+                                                                                 size_t end) {
+      for (size_t i = begin; i < end; ++i)
+      {
+        size_t first = i * array_size;
+        size_t last = first + array_size < items ? first + array_size : items;
+        std::move(source + first, source + last, out[i]->values);
+        out[i]->count = static_cast<int>(last - first);
+        out[i]->prev = i > 0 ? out[i - 1] : nullptr;
+        out[i]->next = i + 1 < out_count ? out[i + 1] : nullptr;
+      }
+    });
+  }
+  catch (...)
+  {
+    for (auto node : result)
+      delete node;
+    throw;
+  }
+
+  for (size_t i = 0; i < count; ++i)
+    delete nodes[i];
+
+  head_ = result.front();
+  tail_ = result.back();
+  stats_.NodeCount = static_cast<int>(result.size());
+}
+
+/**
+ * @brief Replaces the nodes of the BList with the k-way merge of sorted nodes.
+ *
+ * A min-heap holds the next unmerged item of every node, so each item costs
+ * O(log k) compares for k nodes. The output is written into new nodes that
+ * are filled completely, and the old nodes are freed once the merge is done.
+ *
+ * @param nodes The nodes of the list, in order, each one sorted.
+ * @param count The number of nodes.
+ * @throws BListException with E_NO_MEMORY if a node cannot be allocated;
+ *         the list is unchanged in that case.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::mergeSortedNodes(BNode *const *nodes, size_t count)
+{
+  struct Cursor
+  {
+    const BNode *node; //!< node being merged
+    int index;         //!< next unmerged slot in node
+  };
+
+  // std heaps keep the greatest element on top, so order by "greater than"
+  auto later = [](const Cursor &lhs, const Cursor &rhs) {
+    return rhs.node->values[rhs.index] < lhs.node->values[lhs.index];
+  };
+
+  std::vector<Cursor> heap;
+  heap.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    if (nodes[i]->count)
+      heap.push_back(Cursor{nodes[i], 0});
+  std::make_heap(heap.begin(), heap.end(), later);
+
+  BNode *head = nullptr;
+  BNode *tail = nullptr;
+  auto node_count = 0;
+  try
+  {
+    while (!heap.empty())
+    {
+      if (!tail || tail->count == stats_.ArraySize)
+      {
+        auto node = createNode();
+        node->prev = tail;
+        if (tail)
+          tail->next = node;
+        else
+          head = node;
+        tail = node;
+        ++node_count;
+      }
+
+      std::pop_heap(heap.begin(), heap.end(), later);
+      auto &next = heap.back();
+      tail->values[tail->count++] = next.node->values[next.index];
+      if (++next.index < next.node->count)
+        std::push_heap(heap.begin(), heap.end(), later);
+      else
+        heap.pop_back();
+    }
+  }
+  catch (...)
+  {
+    while (head)
+    {
+      auto next = head->next;
+      delete head;
+      head = next;
+    }
+    throw;
+  }
+
+  for (size_t i = 0; i < count; ++i)
+    delete nodes[i];
+
+  head_ = head;
+  tail_ = tail;
+  stats_.NodeCount = node_count;
+}
+
+/**
+ * @brief Creates a new BNode object.
+ *
+ * This function creates a new BNode object by allocating memory and copying the values from the given BNode object.
+ * If the given BNode object is null, the new BNode object will be initialized with default values.
+ *
+ * @param rhs The BNode object to copy values from.
+ * @return A pointer to the newly created BNode object.
+ * @throws BListException if there is not enough memory to create the new BNode object.
+ */
+template <typename T, unsigned Size>
+typename BList<T, Size>::BNode *BList<T, Size>::createNode(const BNode *rhs)
+{
+  auto new_node = new (std::nothrow) BNode;
+  if (!new_node)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_NO_MEMORY, "Not enough memory to create a new node!"};
+
+  if (rhs)
   {
     new_node->next = rhs->next;
     new_node->prev = rhs->prev;
@@ -650,6 +1941,102 @@ typename BList<T, Size>::BNode *BList<T, Size>::getNodeAtIndex(int index) const
   return current;
 }
 
+/**
+ * @brief Fixes up a node after an item has been removed from it.
+ *
+ * An empty node is always freed. With rebalancing enabled, a node below half
+ * full first tries to borrow from the next node, then from the previous one,
+ * and otherwise merges with whichever neighbour it fits into.
+ *
+ * (node, index) is a position within the node (index may equal count). On
+ * return it refers to the same logical position after items have moved.
+ *
+ * @param node The node an item was removed from.
+ * @param index A position within the node, updated on return.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::handleUnderflow(BNode *&node, int &index)
+{
+  if (node->count == 0)
+  {
+    auto next = node->next;
+    freeNode(node);
+    node = next;
+    index = 0;
+    return;
+  }
+
+  if (!rebalance_ || node->count * 2 >= stats_.ArraySize)
+    return;
+
+  auto next = node->next;
+  auto prev = node->prev;
+
+  if (next && (next->count - 1) * 2 >= stats_.ArraySize)
+  {
+    borrowFromNext(node);
+  }
+  else if (prev && (prev->count - 1) * 2 >= stats_.ArraySize)
+  {
+    borrowFromPrev(node);
+    ++index;
+  }
+  else if (next && node->count + next->count <= stats_.ArraySize)
+  {
+    // Pull the next node into this one; positions in this node are unchanged
+    mergeIntoPrev(next);
+  }
+  else if (prev && prev->count + node->count <= stats_.ArraySize)
+  {
+    index += prev->count;
+    mergeIntoPrev(node);
+    node = prev;
+  }
+}
+
+/**
+ * @brief Moves the first item of the next node to the end of a node.
+ *
+ * @param node The node receiving the item.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::borrowFromNext(BNode *node)
+{
+  auto next = node->next;
+  node->values[node->count++] = next->values[0];
+  for (auto i = 0; i < next->count - 1; ++i)
+    next->values[i] = next->values[i + 1];
+  --next->count;
+}
+
+/**
+ * @brief Moves the last item of the previous node to the front of a node.
+ *
+ * @param node The node receiving the item.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::borrowFromPrev(BNode *node)
+{
+  auto prev = node->prev;
+  shiftValuesForInsertion(node, 0);
+  node->values[0] = prev->values[--prev->count];
+  ++node->count;
+}
+
+/**
+ * @brief Appends all items of a node to its previous node and frees it.
+ *
+ * @param node The node to merge away; its previous node must have room.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::mergeIntoPrev(BNode *node)
+{
+  auto prev = node->prev;
+  for (auto i = 0; i < node->count; ++i)
+    prev->values[prev->count++] = node->values[i];
+  freeNode(node);
+}
+
 /**
  * @brief Frees a node from the BList.
  *
@@ -666,7 +2053,10 @@ void BList<T, Size>::freeNode(BNode *node)
   if (node->prev)
     node->prev->next = node->next;
   else
+  {
     head_ = node->next;
+    front_gap_ = 0;
+  }
 
   if (node->next)
     node->next->prev = node->prev;
@@ -868,52 +2258,113 @@ void BList<T, Size>::updateTailIfNeeded(BNode *node, BNode *new_node)
 template <typename T, unsigned Size>
 T &BList<T, Size>::valueAtIndex(int index) const
 {
-  auto current = findNodeContainingIndex(index);
-  auto relativeIndex = calculateRelativeIndex(index, current);
-  
+  auto relativeIndex = 0;
+  auto current = findNodeContainingIndex(index, relativeIndex);
+
   return current->values[relativeIndex];
 }
 
 /**
  * @brief Finds the BNode containing the given index in the BList.
- * 
+ *
+ * The walk starts from whichever of the head, the tail and the cursor (the
+ * node found by the previous lookup and the index of its first item) is
+ * closest to the index, and moves forwards or backwards from there. Indices
+ * near either end and lookups near the cursor are therefore cheap. The
+ * cursor is only read here; the non-const operator[] moves it.
+ *
  * @param index The index to search for.
- * @return A pointer to the BNode containing the index, or nullptr if not found.
+ * @param relative Set to the slot of the index within the node's array.
+ * @return A pointer to the BNode containing the index.
+ * @throws BListException with E_BAD_INDEX if the index is out of range.
  */
 template <typename T, unsigned Size>
-typename BList<T, Size>::BNode* BList<T, Size>::findNodeContainingIndex(int index) const
+typename BList<T, Size>::BNode* BList<T, Size>::findNodeContainingIndex(int index, int &relative) const
 {
+  if (index < 0 || index >= stats_.ItemCount)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_BAD_INDEX, "Index out of range!"};
+
+  // Start at the head, then switch to the tail or the cursor if closer
   auto current = head_;
-  auto total_index = current->count;
+  auto start = 0;
+  auto distance = index;
+
+  auto tail_start = stats_.ItemCount - tail_->count;
+  if (stats_.ItemCount - 1 - index < distance)
+  {
+    current = tail_;
+    start = tail_start;
+    distance = stats_.ItemCount - 1 - index;
+  }
 
-  while (total_index <= index)
+  if (cursor_node_)
   {
+    auto cursor_distance = index < cursor_start_ ? cursor_start_ - index : index - cursor_start_;
+    if (cursor_distance < distance)
+    {
+      current = cursor_node_;
+      start = cursor_start_;
+    }
+  }
+
+  while (index >= start + current->count)
+  {
+    start += current->count;
     current = current->next;
-    if (current)
-      total_index += current->count;
+  }
+  while (index < start)
+  {
+    current = current->prev;
+    start -= current->count;
   }
 
+  relative = firstSlot(current) + index - start;
   return current;
 }
 
 /**
- * @brief Calculates the relative index of a given index within a BNode.
- * 
- * The relative index is the index within the BNode, taking into account the previous nodes.
+ * @brief Forgets the cached lookup position.
  *
- * @param index The index to calculate the relative index for.
- * @param node The BNode to calculate the relative index within.
- * @return The relative index of the given index within the BNode.
+ * Called by every operation that can move items between nodes or free a
+ * node, since the cursor's node or starting index may no longer be valid.
  */
 template <typename T, unsigned Size>
-int BList<T, Size>::calculateRelativeIndex(int index, BNode* node) const
+void BList<T, Size>::invalidateCursor()
 {
-  auto relativeIndex = index;
+  cursor_node_ = nullptr;
+  cursor_start_ = 0;
+}
 
-  for (auto temp = head_; temp != node; temp = temp->next)
-    relativeIndex -= temp->count;
+/**
+ * @brief Returns the slot of a node's first item.
+ *
+ * @param node A node of this BList.
+ * @return The size of the gap in front of the head's items in deque mode, 0
+ *         for every other node.
+ */
+template <typename T, unsigned Size>
+int BList<T, Size>::firstSlot(const BNode *node) const
+{
+  return node == head_ ? front_gap_ : 0;
+}
+
+/**
+ * @brief Moves the head's items back to slot 0 after deque-mode front pushes.
+ *
+ * Operations that shift items within or between nodes expect a node's items
+ * in values[0, count), so they call this first. Read-only operations never
+ * do; they skip the gap with firstSlot. It is a no-op outside deque mode.
+ */
+template <typename T, unsigned Size>
+void BList<T, Size>::normalizeHead()
+{
+  if (!front_gap_)
+    return;
 
-  return relativeIndex;
+  for (auto i = 0; i < head_->count; ++i)
+    head_->values[i] = head_->values[front_gap_ + i];
+  front_gap_ = 0;
 }
 
 /**
@@ -948,7 +2399,7 @@ void BList<T, Size>::insertAtIndex(BNode *node, int index, const T &value)
 template <typename T, unsigned Size>
 void BList<T, Size>::removeAtIndex(BNode *node, int index)
 {
-  for (auto i = index; i < node->count; ++i)
+  for (auto i = index; i < node->count - 1; ++i)
     node->values[i] = node->values[i + 1];
   --node->count;
   --stats_.ItemCount;
@@ -15,7 +15,12 @@
 #define BLIST_H
 ////////////////////////////////////////////////////////////////////////////////
 
-#include <string> // error strings
+#include <string>      // error strings
+#include <cstddef>     // std::ptrdiff_t
+#include <cstdint>     // std::uint32_t, std::uint64_t
+#include <iosfwd>      // std::istream, std::ostream
+#include <iterator>    // std::bidirectional_iterator_tag, std::iterator_traits
+#include <type_traits> // std::enable_if, std::is_convertible
 
 /*!
   The exception class for BList
@@ -102,12 +107,53 @@ struct BListStats
   */
   BListStats(size_t nsize, int ncount, int asize, int count) : NodeSize(nsize), NodeCount(ncount), ArraySize(asize), ItemCount(count){};
 
+  /*!
+    Fraction of the allocated item slots that are in use
+
+    \return
+      ItemCount / (NodeCount * ArraySize), or 0 for an empty list
+  */
+  double FillFactor() const
+  {
+    if (NodeCount == 0 || ArraySize == 0)
+      return 0.0;
+    return static_cast<double>(ItemCount) / (static_cast<double>(NodeCount) * ArraySize);
+  }
+
   size_t NodeSize; //!< Size of a node (via sizeof)
   int NodeCount;   //!< Number of nodes in the list
   int ArraySize;   //!< Max number of items in each node
   int ItemCount;   //!< Number of items in the entire list
 };
 
+/*!
+  Header at the start of a binary image written by BList::save. The items
+  follow at DataOffset(alignof(T)) as one contiguous array, in the byte
+  order of the machine that wrote them.
+*/
+struct BListImageHeader
+{
+  char Magic[4];           //!< Always "BLST"
+  std::uint32_t Version;   //!< Format version, currently 1
+  std::uint32_t ItemSize;  //!< sizeof(T) of the writer
+  std::uint32_t ArraySize; //!< Max number of items in each node of the writer
+  std::uint64_t ItemCount; //!< Number of items in the image
+
+  /*!
+    Offset of the first item from the start of the image
+
+    \param alignment
+      The alignment of the item type.
+
+    \return
+      The size of the header rounded up to the alignment.
+  */
+  static size_t DataOffset(size_t alignment)
+  {
+    return (sizeof(BListImageHeader) + alignment - 1) / alignment * alignment;
+  }
+};
+
 /*!
   The BList class
 */
@@ -130,8 +176,119 @@ public:
     BNode() : next(0), prev(0), count(0) {}
   };
 
+  /*!
+    Bidirectional iterator over the items of the BList.
+    An iterator is a node pointer plus a slot index into that node's array.
+    The end iterator has a null node; decrementing it moves to the last item.
+  */
+  template <typename U, typename NodeT>
+  class Iterator
+  {
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category; //!< Iterator category
+    typedef T value_type;                                      //!< Type of the items
+    typedef std::ptrdiff_t difference_type;                    //!< Distance between iterators
+    typedef U *pointer;                                        //!< Pointer to an item
+    typedef U &reference;                                      //!< Reference to an item
+
+    //!< Default constructor (singular iterator)
+    Iterator() : node_(nullptr), index_(0), list_(nullptr) {}
+
+    /*!
+      Converting constructor (iterator to const_iterator)
+
+      \param rhs
+        The iterator to convert from.
+    */
+    template <typename V, typename N,
+              typename = typename std::enable_if<std::is_convertible<N *, NodeT *>::value>::type>
+    Iterator(const Iterator<V, N> &rhs) : node_(rhs.node_), index_(rhs.index_), list_(rhs.list_) {}
+
+    //!< Access the item the iterator refers to
+    reference operator*() const { return node_->values[index_]; }
+
+    //!< Access a member of the item the iterator refers to
+    pointer operator->() const { return &node_->values[index_]; }
+
+    //!< Pre-increment, moves to the next node when the current one is exhausted
+    Iterator &operator++()
+    {
+      if (++index_ >= list_->firstSlot(node_) + node_->count)
+      {
+        node_ = node_->next;
+        index_ = 0;
+      }
+      return *this;
+    }
+
+    //!< Post-increment
+    Iterator operator++(int)
+    {
+      Iterator temp(*this);
+      ++*this;
+      return temp;
+    }
+
+    //!< Pre-decrement, the end iterator moves to the last item in the list
+    Iterator &operator--()
+    {
+      if (!node_)
+      {
+        node_ = list_->tail_;
+        index_ = list_->firstSlot(node_) + node_->count - 1;
+      }
+      else if (index_ == list_->firstSlot(node_))
+      {
+        node_ = node_->prev;
+        index_ = list_->firstSlot(node_) + node_->count - 1;
+      }
+      else
+        --index_;
+      return *this;
+    }
+
+    //!< Post-decrement
+    Iterator operator--(int)
+    {
+      Iterator temp(*this);
+      --*this;
+      return temp;
+    }
+
+    //!< Two iterators are equal if they refer to the same slot of the same node
+    friend bool operator==(const Iterator &lhs, const Iterator &rhs)
+    {
+      return lhs.node_ == rhs.node_ && lhs.index_ == rhs.index_;
+    }
+
+    //!< Inequality, see operator==
+    friend bool operator!=(const Iterator &lhs, const Iterator &rhs)
+    {
+      return !(lhs == rhs);
+    }
+
+  private:
+    friend class BList;
+    template <typename, typename>
+    friend class Iterator;
+
+    //!< Constructor used by the BList
+    Iterator(NodeT *node, int index, const BList *list) : node_(node), index_(index), list_(list) {}
+
+    NodeT *node_;       //!< node containing the item, nullptr for end()
+    int index_;         //!< slot of the item within node_->values
+    const BList *list_; //!< owning list, for stepping back from end() and the head's gap
+  };
+
+  typedef Iterator<T, BNode> iterator;                   //!< Mutable iterator
+  typedef Iterator<const T, const BNode> const_iterator; //!< Read-only iterator
+
   BList();                            // default constructor
+  explicit BList(int capacity);       // fill nodes to at most capacity (<= Size) items
   BList(const BList &rhs);            // copy constructor
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::iterator_category>
+  BList(InputIt first, InputIt last); // range constructor (iterators only)
   ~BList();                           // destructor
   BList &operator=(const BList &rhs); // assign operator
 
@@ -139,24 +296,76 @@ public:
   void push_back(const T &value);
   void push_front(const T &value);
 
+  // bulk loading into packed nodes (unsorted, like push_back)
+  template <typename InputIt>
+  void append(InputIt first, InputIt last);
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last);
+
   // arrays will be sorted, if calling this
   void insert(const T &value);
+  template <typename InputIt>
+  void build_from_sorted(InputIt first, InputIt last);
 
   void remove(int index);
   void remove_by_value(const T &value);
 
   int find(const T &value) const; // returns index, -1 if not found
 
-  T &operator[](int index);             // for l-values
-  const T &operator[](int index) const; // for r-values
+  // resumes from the node of the previous non-const lookup, so sequential access is O(1)
+  T &operator[](int index);             // for l-values, moves the lookup cursor
+  const T &operator[](int index) const; // for r-values, read-only (safe for concurrent readers)
+
+  // O(1) access to both ends
+  T &front();
+  const T &front() const;
+  T &back();
+  const T &back() const;
+  void pop_front();
+  void pop_back();
 
   size_t size() const; // total number of items (not nodes)
   void clear();        // delete all nodes
 
   static size_t nodesize(); // so the allocator knows the size
 
+  int capacity() const; // fill limit per node (Size unless set at construction)
+
+  // iteration (range-for)
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+
+  // positional insert/erase, linear-time when driven by an iterator
+  iterator insert(const_iterator position, const T &value);
+  iterator erase(const_iterator position);
+
+  // B-tree style borrowing/merging of under-full nodes on removal (off by default)
+  void set_rebalance(bool enable);
+  bool rebalancing() const;
+
+  // head node fills from the back on push_front, for double-ended queue use (off by default)
+  void set_deque_mode(bool enable);
+  bool deque_mode() const;
+
+  // moving items between lists by relinking nodes, without copying every item
+  void splice(BList &other);              // append all of other, O(1)
+  void split_at(int index, BList &rest);  // move [index, size()) into rest
+  void merge(BList &other);               // merge sorted other into this sorted list
+
+  // sorts the items into packed nodes (in parallel for large lists), like build_from_sorted
+  void sort();
+
+  // binary image of the items, T must be trivially copyable
+  void save(std::ostream &out) const;
+  void load(std::istream &in);
+
   // For debugging
   const BNode *GetHead() const;
+  int head_offset() const; // slot of the head's first item, 0 outside deque mode
   BListStats GetStats() const;
 
 private:
@@ -164,8 +373,24 @@ private:
   BNode *tail_; //!< points to the last node
 
   // Other private data and methods you may need ...
+  static const int ParallelCopyItems = 1 << 18; //!< lists this large are copied in parallel
+  static const int ParallelSortItems = 1 << 16; //!< lists this large are sorted in parallel
+
   BListStats stats_;
+  bool rebalance_; //!< merge/borrow when a node drops below half full
+  bool deque_;     //!< push_front fills the head node from the back
+
+  // In deque mode the head's items are values[front_gap_, front_gap_ + count)
+  int front_gap_; //!< free slots before the head's first item, 0 outside deque mode
+
+  // Cached position of the last non-const index lookup (reset by structural changes).
+  // Const members only read it, so they never write to the list.
+  BNode *cursor_node_; //!< node found by the last lookup, or nullptr
+  int cursor_start_;   //!< index of the first item in cursor_node_
   BNode *createNode(const BNode *rhs = nullptr);
+  void copyNodes(const BList &rhs);
+  void copyNodesSerial(const BList &rhs);
+  void copyNodesParallel(const BList &rhs);
   BNode *getNodeAtIndex(int index) const;
   void freeNode(BNode *node);
   void incrementNode(BNode *node);
@@ -189,15 +414,62 @@ private:
   void shiftValuesForInsertion(BNode *node, int index);
   void updateTailIfNeeded(BNode *node, BNode *new_node);
 
-  BNode* findNodeContainingIndex(int index) const;
-  int calculateRelativeIndex(int index, BNode* node) const;
+  // Removal helpers
+  void handleUnderflow(BNode *&node, int &index);
+  void borrowFromNext(BNode *node);
+  void borrowFromPrev(BNode *node);
+  void mergeIntoPrev(BNode *node);
+
+  BNode* findNodeContainingIndex(int index, int &relative) const;
+  void invalidateCursor();
+  int firstSlot(const BNode *node) const;
+  void normalizeHead();
 
   void addToHead(const T &value);
   void createNewNodeAndAddToHead(const T &value);
   void addToTail(const T &value);
   void createNewNodeAndAddToTail(const T &value);
+  void createEmptyNodeAtTail();
+
+  // Merge helpers
+  void linkRemainderAtTail(BNode *node, int first);
+  void linkChainAtTail(BNode *node, int first);
+
+  // Sort helpers
+  void sortEachNode(BNode *const *nodes, size_t count);
+  void mergeSortedNodes(BNode *const *nodes, size_t count);
+  void sortNodesParallel(BNode *const *nodes, size_t count);
+  static size_t mergeSplit(const T *a, size_t a_count, const T *b, size_t b_count, size_t diagonal);
+  template <typename Work>
+  static void forEachChunk(size_t count, size_t chunks, const Work &work);
+  void moveItemToTail(BNode *&node, int &index);
+};
+
+/*!
+  The largest Size for which a BList<T, Size> node fits in Lines cache lines
+  of LineSize bytes, or 1 if not even a one-item node fits. The bytes that
+  are not item slots (next, prev, count and padding) are measured from a
+  one-item node, so the layout the compiler picks is taken into account.
+*/
+template <typename T, unsigned Lines, unsigned LineSize = 64>
+struct NodeSizeFor
+{
+  static_assert(Lines > 0, "A node spans at least one cache line");
+
+  //! Bytes of a node other than its item slots
+  static const size_t Header = sizeof(typename BList<T, 1>::BNode) - sizeof(T);
+  //! Bytes available in Lines cache lines
+  static const size_t Bytes = static_cast<size_t>(Lines) * LineSize;
+  //! Items that fit after the header
+  static const size_t Fit = Bytes > Header ? (Bytes - Header) / sizeof(T) : 0;
+
+  static const unsigned value = Fit > 0 ? static_cast<unsigned>(Fit) : 1; //!< The Size to use
 };
 
+//! A BList whose nodes fill Lines 64-byte cache lines, e.g. CacheBList<int, 2>
+template <typename T, unsigned Lines>
+using CacheBList = BList<T, NodeSizeFor<T, Lines>::value>;
+
 #include "BList.cpp"
 
 #endif // BLIST_H
@@ -0,0 +1,232 @@
+/*!******************************************************************
+ * \file      BListImage.cpp
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course: CSD2183
+ * \par       Section: A
+ * \par
+ * \date      31-01-2024
+ *
+ * \brief     This file contains the definitions for BListView and
+ *            BListImage.
+ *********************************************************************/
+
+#include "BListImage.h"
+#include "BListScan.h" // vectorized search
+#include <climits>     // INT_MAX
+#include <cstring>     // std::memcmp
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+#define BLISTIMAGE_MMAP
+#else
+#include <fstream> // std::ifstream
+#endif
+
+/**
+ * @brief Default constructor, an empty view.
+ */
+template <typename T>
+BListView<T>::BListView() : items_(nullptr), count_(0), array_size_(0)
+{
+}
+
+/**
+ * @brief Constructs a view over a BList image in memory.
+ *
+ * The header is checked against T and the size of the buffer, then the items
+ * are used where they are, without copying.
+ *
+ * @param image The start of the image, aligned for T.
+ * @param bytes The size of the image in bytes.
+ * @throws BListException with E_DATA_ERROR if the image is not a valid
+ *         image of T items.
+ */
+template <typename T>
+BListView<T>::BListView(const void *image, size_t bytes) : BListView()
+{
+  static_assert(std::is_trivially_copyable<T>::value, "BListView requires a trivially copyable T");
+
+  const size_t offset = BListImageHeader::DataOffset(alignof(T));
+  const BListImageHeader *header = static_cast<const BListImageHeader *>(image);
+
+  if (!image || bytes < offset || reinterpret_cast<std::uintptr_t>(image) % alignof(T) != 0 ||
+      std::memcmp(header->Magic, "BLST", sizeof(header->Magic)) != 0 || header->Version != 1 ||
+      header->ItemSize != sizeof(T) || header->ItemCount > static_cast<std::uint64_t>(INT_MAX) ||
+      header->ItemCount > (bytes - offset) / sizeof(T))
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_DATA_ERROR, "Not a BList image for this type!"};
+
+  items_ = reinterpret_cast<const T *>(static_cast<const char *>(image) + offset);
+  count_ = static_cast<int>(header->ItemCount);
+  array_size_ = static_cast<int>(header->ArraySize);
+}
+
+/**
+ * @brief Finds the index of the first occurrence of the specified value.
+ *
+ * The items are contiguous, so the whole image is searched in one
+ * BListScan::find call.
+ *
+ * @param value The value to search for.
+ * @return The index of the first occurrence of the value, or -1 if not found.
+ */
+template <typename T>
+int BListView<T>::find(const T &value) const
+{
+  return count_ ? BListScan::find(items_, count_, value) : -1;
+}
+
+/**
+ * @brief Returns the item at the specified index, in O(1).
+ *
+ * @param index The index of the item.
+ * @return A reference to the item in the image.
+ * @throws BListException with E_BAD_INDEX if the index is out of range.
+ */
+template <typename T>
+const T &BListView<T>::operator[](int index) const
+{
+  if (index < 0 || index >= count_)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_BAD_INDEX, "Index out of range!"};
+  return items_[index];
+}
+
+/**
+ * @brief Returns the number of items in the view.
+ *
+ * @return The number of items.
+ */
+template <typename T>
+size_t BListView<T>::size() const
+{
+  return static_cast<size_t>(count_);
+}
+
+/**
+ * @brief Returns the node size recorded by the list that wrote the image.
+ *
+ * @return The ArraySize of the writer.
+ */
+template <typename T>
+int BListView<T>::array_size() const
+{
+  return array_size_;
+}
+
+/**
+ * @brief Returns a pointer to the first item.
+ *
+ * @return The first item, or nullptr for an empty view.
+ */
+template <typename T>
+const T *BListView<T>::begin() const
+{
+  return items_;
+}
+
+/**
+ * @brief Returns a pointer one past the last item.
+ *
+ * @return The end of the items.
+ */
+template <typename T>
+const T *BListView<T>::end() const
+{
+  return items_ + count_;
+}
+
+/**
+ * @brief Maps a BList image file into memory and validates it.
+ *
+ * With mmap the pages are shared with the page cache and only loaded as
+ * they are touched, so opening a large image is almost free.
+ *
+ * @param path The file written by BList::save.
+ * @throws BListException with E_DATA_ERROR if the file cannot be opened or
+ *         is not a valid image of T items.
+ */
+template <typename T>
+BListImage<T>::BListImage(const char *path) : data_(nullptr), bytes_(0)
+{
+#ifdef BLISTIMAGE_MMAP
+  int fd = open(path, O_RDONLY);
+  struct stat info;
+  if (fd >= 0 && fstat(fd, &info) == 0 && info.st_size > 0)
+  {
+    void *data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED)
+    {
+      data_ = data;
+      bytes_ = static_cast<size_t>(info.st_size);
+    }
+  }
+  if (fd >= 0)
+    close(fd);
+#else
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (file)
+  {
+    bytes_ = static_cast<size_t>(file.tellg());
+    data_ = new char[bytes_];
+    file.seekg(0);
+    // A short read would leave garbage behind a valid header, so treat it as
+    // a file that cannot be opened
+    if (!file.read(static_cast<char *>(data_), static_cast<std::streamsize>(bytes_)))
+      release();
+  }
+#endif
+
+  if (!data_)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_DATA_ERROR, "Cannot open the BList image!"};
+
+  try
+  {
+    view_ = BListView<T>(data_, bytes_);
+  }
+  catch (...)
+  {
+    release();
+    throw;
+  }
+}
+
+/**
+ * @brief Unmaps the image file.
+ */
+template <typename T>
+BListImage<T>::~BListImage()
+{
+  release();
+}
+
+/**
+ * @brief Unmaps (or frees) the image memory.
+ */
+template <typename T>
+void BListImage<T>::release()
+{
+#ifdef BLISTIMAGE_MMAP
+  if (data_)
+    munmap(data_, bytes_);
+#else
+  delete[] static_cast<char *>(data_);
+#endif
+  data_ = nullptr;
+}
+
+/**
+ * @brief Returns the read-only list over the mapped items.
+ *
+ * @return The view, valid for the lifetime of the BListImage.
+ */
+template <typename T>
+const BListView<T> &BListImage<T>::view() const
+{
+  return view_;
+}
@@ -0,0 +1,75 @@
+/*!******************************************************************
+ * \file      BListImage.h
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course: CSD2183
+ * \par       Section: A
+ * \par
+ * \date      31-01-2024
+ *
+ * \brief     This file contains the declarations for BListView, a
+ *            read-only list over a binary image written by BList::save,
+ *            and BListImage, which memory-maps such an image from a file.
+ *********************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef BLISTIMAGE_H
+#define BLISTIMAGE_H
+////////////////////////////////////////////////////////////////////////////////
+
+#include "BList.h" // BListException, BListImageHeader
+
+/*!
+  A read-only list over the items of a BList image, used in place.
+  Nothing is copied, so the memory must outlive the view.
+*/
+template <typename T>
+class BListView
+{
+public:
+  BListView();                                // empty view
+  BListView(const void *image, size_t bytes); // view of an image in memory
+
+  int find(const T &value) const;       // returns index, -1 if not found
+  const T &operator[](int index) const; // for r-values
+
+  size_t size() const;   // total number of items
+  int array_size() const; // items per node of the list that wrote the image
+
+  const T *begin() const;
+  const T *end() const;
+
+private:
+  const T *items_;  //!< first item in the image
+  int count_;       //!< number of items
+  int array_size_;  //!< ArraySize recorded in the header
+};
+
+/*!
+  A BList image file mapped read-only into memory, for fast warm restarts.
+  On systems without mmap the file is read into memory instead.
+*/
+template <typename T>
+class BListImage
+{
+public:
+  explicit BListImage(const char *path); // map the file
+  ~BListImage();                         // unmap the file
+
+  // The mapping is owned, so images are not copied
+  BListImage(const BListImage &rhs) = delete;
+  BListImage &operator=(const BListImage &rhs) = delete;
+
+  const BListView<T> &view() const;
+
+private:
+  void *data_;         //!< start of the mapped file
+  size_t bytes_;       //!< size of the mapped file
+  BListView<T> view_;  //!< the items in the file
+
+  void release();
+};
+
+#include "BListImage.cpp"
+
+#endif // BLISTIMAGE_H
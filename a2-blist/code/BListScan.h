@@ -0,0 +1,321 @@
+/*!******************************************************************
+ * \file      BListScan.h
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course: CSD2183
+ * \par       Section: A
+ * \par
+ * \date      31-01-2024
+ *
+ * \brief     Linear search of a node's values array, used by BList::find
+ *            and BList::remove_by_value. Integral and floating-point
+ *            element types are compared a vector register at a time with
+ *            SSE2, or AVX2 when the compiler targets it (-mavx2). Other
+ *            types, and builds without SSE2, use a plain == loop.
+ *********************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef BLISTSCAN_H
+#define BLISTSCAN_H
+////////////////////////////////////////////////////////////////////////////////
+
+#include <type_traits> // std::is_integral, std::integral_constant
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h> // SSE2/AVX2 intrinsics
+#define BLISTSCAN_SIMD
+#endif
+
+namespace BListScan
+{
+  /*!
+    Finds the first slot holding a value, comparing with operator==.
+
+    \param values
+      The array to search.
+
+    \param count
+      The number of items in the array.
+
+    \param value
+      The value to search for.
+
+    \return
+      The index of the first match, or -1 if there is none.
+  */
+  template <typename T>
+  int findScalar(const T *values, int count, const T &value)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      if (values[i] == value)
+        return i;
+    }
+    return -1;
+  }
+
+#ifdef BLISTSCAN_SIMD
+  //! Kinds of element handled by the vector search
+  enum ScanKind
+  {
+    SK_GENERIC,
+    SK_INTEGRAL,
+    SK_FLOAT,
+    SK_DOUBLE
+  };
+
+  //! Selects the ScanKind for an element type
+  template <typename T>
+  struct KindOf
+      : std::integral_constant<int, std::is_integral<T>::value && sizeof(T) <= 8 ? SK_INTEGRAL
+                                    : std::is_same<T, float>::value              ? SK_FLOAT
+                                    : std::is_same<T, double>::value             ? SK_DOUBLE
+                                                                                 : SK_GENERIC>
+  {
+  };
+
+  /*!
+    Returns the index of the lowest set bit of a non-zero mask.
+
+    \param mask
+      The mask, must not be zero.
+
+    \return
+      The bit index.
+  */
+  inline int lowestBit(unsigned mask)
+  {
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while (!(mask & 1u))
+    {
+      mask >>= 1;
+      ++bit;
+    }
+    return bit;
+#endif
+  }
+
+  /*!
+    Turns a byte mask from movemask into the first lane whose bytes all
+    matched. Integer lanes are compared with the widest compare available
+    (at most 32 bits), so a 64-bit lane only matches if both halves did.
+
+    \param mask
+      One bit per byte of the register.
+
+    \param width
+      The size of a lane in bytes.
+
+    \return
+      The index of the first matching lane, or -1.
+  */
+  inline int firstFullLane(unsigned mask, unsigned width)
+  {
+    const unsigned full = (1u << width) - 1u;
+    while (mask)
+    {
+      unsigned lane = static_cast<unsigned>(lowestBit(mask)) / width;
+      if (((mask >> (lane * width)) & full) == full)
+        return static_cast<int>(lane);
+      mask &= ~(full << (lane * width));
+    }
+    return -1;
+  }
+
+#if defined(__AVX2__)
+  //! Broadcast an integer to every lane of a register, by lane width
+  inline __m256i splat(const void *p, std::integral_constant<unsigned, 1>)
+  {
+    return _mm256_set1_epi8(*static_cast<const char *>(p));
+  }
+  inline __m256i splat(const void *p, std::integral_constant<unsigned, 2>)
+  {
+    return _mm256_set1_epi16(*static_cast<const short *>(p));
+  }
+  inline __m256i splat(const void *p, std::integral_constant<unsigned, 4>)
+  {
+    return _mm256_set1_epi32(*static_cast<const int *>(p));
+  }
+  inline __m256i splat(const void *p, std::integral_constant<unsigned, 8>)
+  {
+    return _mm256_set1_epi64x(*static_cast<const long long *>(p));
+  }
+
+  //! Lane-wise equality of two registers, by lane width
+  inline __m256i equal(__m256i a, __m256i b, std::integral_constant<unsigned, 1>)
+  {
+    return _mm256_cmpeq_epi8(a, b);
+  }
+  inline __m256i equal(__m256i a, __m256i b, std::integral_constant<unsigned, 2>)
+  {
+    return _mm256_cmpeq_epi16(a, b);
+  }
+  inline __m256i equal(__m256i a, __m256i b, std::integral_constant<unsigned, 4>)
+  {
+    return _mm256_cmpeq_epi32(a, b);
+  }
+  inline __m256i equal(__m256i a, __m256i b, std::integral_constant<unsigned, 8>)
+  {
+    return _mm256_cmpeq_epi64(a, b);
+  }
+#else
+  //! Broadcast an integer to every lane of a register, by lane width
+  inline __m128i splat(const void *p, std::integral_constant<unsigned, 1>)
+  {
+    return _mm_set1_epi8(*static_cast<const char *>(p));
+  }
+  inline __m128i splat(const void *p, std::integral_constant<unsigned, 2>)
+  {
+    return _mm_set1_epi16(*static_cast<const short *>(p));
+  }
+  inline __m128i splat(const void *p, std::integral_constant<unsigned, 4>)
+  {
+    return _mm_set1_epi32(*static_cast<const int *>(p));
+  }
+  inline __m128i splat(const void *p, std::integral_constant<unsigned, 8>)
+  {
+    return _mm_set1_epi64x(*static_cast<const long long *>(p));
+  }
+
+  //! Lane-wise equality of two registers, by lane width (SSE2 has no 64-bit compare)
+  inline __m128i equal(__m128i a, __m128i b, std::integral_constant<unsigned, 1>)
+  {
+    return _mm_cmpeq_epi8(a, b);
+  }
+  inline __m128i equal(__m128i a, __m128i b, std::integral_constant<unsigned, 2>)
+  {
+    return _mm_cmpeq_epi16(a, b);
+  }
+  inline __m128i equal(__m128i a, __m128i b, std::integral_constant<unsigned, 4>)
+  {
+    return _mm_cmpeq_epi32(a, b);
+  }
+  inline __m128i equal(__m128i a, __m128i b, std::integral_constant<unsigned, 8>)
+  {
+    return _mm_cmpeq_epi32(a, b);
+  }
+#endif
+
+  //! Integral elements: bitwise equality is the same as ==
+  template <typename T>
+  int findVector(const T *values, int count, const T &value, std::integral_constant<int, SK_INTEGRAL>)
+  {
+    typedef std::integral_constant<unsigned, sizeof(T)> Width;
+    int i = 0;
+#if defined(__AVX2__)
+    const int lanes = static_cast<int>(32 / sizeof(T));
+    const __m256i needle = splat(&value, Width());
+    for (; i + lanes <= count; i += lanes)
+    {
+      __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+      unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(equal(block, needle, Width())));
+      int lane = mask ? firstFullLane(mask, sizeof(T)) : -1;
+      if (lane >= 0)
+        return i + lane;
+    }
+#else
+    const int lanes = static_cast<int>(16 / sizeof(T));
+    const __m128i needle = splat(&value, Width());
+    for (; i + lanes <= count; i += lanes)
+    {
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+      unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(equal(block, needle, Width())));
+      int lane = mask ? firstFullLane(mask, sizeof(T)) : -1;
+      if (lane >= 0)
+        return i + lane;
+    }
+#endif
+    int rest = findScalar(values + i, count - i, value);
+    return rest < 0 ? -1 : i + rest;
+  }
+
+  //! float elements: ordered compare, so NaN never matches and -0 == +0 as with ==
+  template <typename T>
+  int findVector(const T *values, int count, const T &value, std::integral_constant<int, SK_FLOAT>)
+  {
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256 needle = _mm256_set1_ps(value);
+    for (; i + 8 <= count; i += 8)
+    {
+      int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(values + i), needle, _CMP_EQ_OQ));
+      if (mask)
+        return i + lowestBit(static_cast<unsigned>(mask));
+    }
+#else
+    const __m128 needle = _mm_set1_ps(value);
+    for (; i + 4 <= count; i += 4)
+    {
+      int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(values + i), needle));
+      if (mask)
+        return i + lowestBit(static_cast<unsigned>(mask));
+    }
+#endif
+    int rest = findScalar(values + i, count - i, value);
+    return rest < 0 ? -1 : i + rest;
+  }
+
+  //! double elements, see the float version
+  template <typename T>
+  int findVector(const T *values, int count, const T &value, std::integral_constant<int, SK_DOUBLE>)
+  {
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256d needle = _mm256_set1_pd(value);
+    for (; i + 4 <= count; i += 4)
+    {
+      int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(values + i), needle, _CMP_EQ_OQ));
+      if (mask)
+        return i + lowestBit(static_cast<unsigned>(mask));
+    }
+#else
+    const __m128d needle = _mm_set1_pd(value);
+    for (; i + 2 <= count; i += 2)
+    {
+      int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(values + i), needle));
+      if (mask)
+        return i + lowestBit(static_cast<unsigned>(mask));
+    }
+#endif
+    int rest = findScalar(values + i, count - i, value);
+    return rest < 0 ? -1 : i + rest;
+  }
+
+  //! Everything else compares with operator==
+  template <typename T>
+  int findVector(const T *values, int count, const T &value, std::integral_constant<int, SK_GENERIC>)
+  {
+    return findScalar(values, count, value);
+  }
+#endif // BLISTSCAN_SIMD
+
+  /*!
+    Finds the first slot holding a value, vectorized for arithmetic types.
+
+    \param values
+      The array to search.
+
+    \param count
+      The number of items in the array.
+
+    \param value
+      The value to search for.
+
+    \return
+      The index of the first match, or -1 if there is none.
+  */
+  template <typename T>
+  int find(const T *values, int count, const T &value)
+  {
+#ifdef BLISTSCAN_SIMD
+    return findVector(values, count, value, std::integral_constant<int, KindOf<T>::value>());
+#else
+    return findScalar(values, count, value);
+#endif
+  }
+}
+
+#endif // BLISTSCAN_H
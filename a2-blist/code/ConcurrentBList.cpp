@@ -0,0 +1,368 @@
+/*!******************************************************************
+ * \file      ConcurrentBList.cpp
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course: CSD2183
+ * \par       Section: A
+ * \par
+ * \date      31-01-2024
+ *
+ * \brief     This file contains the definitions for the ConcurrentBList.
+ *********************************************************************/
+
+#include <mutex> // std::unique_lock
+#include "ConcurrentBList.h"
+
+template <typename T, unsigned Size>
+size_t ConcurrentBList<T, Size>::nodesize(void)
+{
+  return sizeof(CNode);
+}
+
+/**
+ * @brief Default constructor for the ConcurrentBList class.
+ *
+ * The list starts with only the sentinel head node.
+ */
+template <typename T, unsigned Size>
+ConcurrentBList<T, Size>::ConcurrentBList() : head_(), node_count_(0), item_count_(0)
+{
+}
+
+/**
+ * @brief Destructor for the ConcurrentBList class.
+ *
+ * No other thread may be using the list while it is destroyed.
+ */
+template <typename T, unsigned Size>
+ConcurrentBList<T, Size>::~ConcurrentBList()
+{
+  clear();
+}
+
+/**
+ * @brief Inserts a value into the ConcurrentBList, keeping it sorted.
+ *
+ * The list is walked with exclusive lock coupling until the first node whose
+ * last item is not less than the value. With that node and its predecessor
+ * locked, the value is placed using the same policy as BList::insert: at the
+ * end of the previous node if it has room, otherwise into the node, splitting
+ * the previous node or the node itself when full.
+ *
+ * @param value The value to be inserted.
+ */
+template <typename T, unsigned Size>
+void ConcurrentBList<T, Size>::insert(const T &value)
+{
+  std::unique_lock<Mutex> prev_lock(head_.lock);
+  CNode *prev = &head_;
+  CNode *current = head_.next;
+  std::unique_lock<Mutex> current_lock;
+
+  while (current)
+  {
+    current_lock = std::unique_lock<Mutex>(current->lock);
+    if (!(current->values[current->count - 1] < value))
+      break;
+
+    // Releases the lock on prev and keeps the one on current
+    prev_lock = std::move(current_lock);
+    prev = current;
+    current = current->next;
+  }
+
+  const int capacity = static_cast<int>(Size);
+  const bool has_prev = prev != &head_;
+
+  if (!current)
+  {
+    // Past the last node: append to the tail, or start the list
+    if (!has_prev)
+    {
+      CNode *node = createNode();
+      node->values[0] = value;
+      node->count = 1;
+      head_.next = node;
+      ++node_count_;
+    }
+    else if (prev->count < capacity)
+      insertAtIndex(prev, prev->count, value);
+    else
+      splitNode(prev, prev->count, value);
+  }
+  else
+  {
+    int index = findInsertionIndex(value, current);
+
+    if (index == 0)
+    {
+      if (has_prev && prev->count < capacity)
+        insertAtIndex(prev, prev->count, value);
+      else if (current->count < capacity)
+        insertAtIndex(current, index, value);
+      else if (has_prev)
+        splitNode(prev, capacity, value);
+      else
+        splitNode(current, index, value);
+    }
+    else if (current->count < capacity)
+      insertAtIndex(current, index, value);
+    else
+      splitNode(current, index, value);
+  }
+
+  ++item_count_;
+}
+
+/**
+ * @brief Removes the first occurrence of the specified value.
+ *
+ * The list is walked with exclusive lock coupling. An emptied node is
+ * unlinked while both it and its predecessor are locked; at that point no
+ * other thread can hold or wait for its lock, so it is safe to delete.
+ *
+ * @param value The value to be removed from the list.
+ */
+template <typename T, unsigned Size>
+void ConcurrentBList<T, Size>::remove_by_value(const T &value)
+{
+  std::unique_lock<Mutex> prev_lock(head_.lock);
+  CNode *prev = &head_;
+  CNode *current = head_.next;
+
+  while (current)
+  {
+    std::unique_lock<Mutex> current_lock(current->lock);
+    for (int i = 0; i < current->count; ++i)
+    {
+      if (current->values[i] == value)
+      {
+        for (int j = i; j < current->count - 1; ++j)
+          current->values[j] = current->values[j + 1];
+        --current->count;
+        --item_count_;
+
+        if (current->count == 0)
+        {
+          prev->next = current->next;
+          current_lock.unlock();
+          delete current;
+          --node_count_;
+        }
+        return;
+      }
+    }
+
+    prev_lock = std::move(current_lock);
+    prev = current;
+    current = current->next;
+  }
+}
+
+/**
+ * @brief Finds the index of the first occurrence of the specified value.
+ *
+ * The list is walked with shared lock coupling, so the index is consistent
+ * with the list at the moment the value was seen.
+ *
+ * @param value The value to search for.
+ * @return The index of the first occurrence of the value, or -1 if not found.
+ */
+template <typename T, unsigned Size>
+int ConcurrentBList<T, Size>::find(const T &value) const
+{
+  std::shared_lock<Mutex> prev_lock(head_.lock);
+  const CNode *current = head_.next;
+  int total_index = 0;
+
+  while (current)
+  {
+    std::shared_lock<Mutex> current_lock(current->lock);
+    prev_lock.unlock();
+
+    for (int i = 0; i < current->count; ++i)
+    {
+      if (current->values[i] == value)
+        return total_index + i;
+    }
+    total_index += current->count;
+
+    prev_lock = std::move(current_lock);
+    current = current->next;
+  }
+  return -1;
+}
+
+/**
+ * @brief Returns a copy of the element at the specified index.
+ *
+ * @param index The index of the element to read.
+ * @return The element at the specified index.
+ * @throws BListException with E_BAD_INDEX if the index is out of range.
+ */
+template <typename T, unsigned Size>
+T ConcurrentBList<T, Size>::operator[](int index) const
+{
+  if (index < 0)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_BAD_INDEX, "Index out of range!"};
+
+  std::shared_lock<Mutex> prev_lock(head_.lock);
+  const CNode *current = head_.next;
+
+  while (current)
+  {
+    std::shared_lock<Mutex> current_lock(current->lock);
+    prev_lock.unlock();
+
+    if (index < current->count)
+      return current->values[index];
+    index -= current->count;
+
+    prev_lock = std::move(current_lock);
+    current = current->next;
+  }
+
+  throw BListException{
+      BListException::BLIST_EXCEPTION::E_BAD_INDEX, "Index out of range!"};
+}
+
+/**
+ * @brief Returns the number of items in the ConcurrentBList.
+ *
+ * @return The number of items, which may already be stale if writers are active.
+ */
+template <typename T, unsigned Size>
+size_t ConcurrentBList<T, Size>::size() const
+{
+  return static_cast<size_t>(item_count_.load());
+}
+
+/**
+ * @brief Removes all items from the ConcurrentBList.
+ *
+ * The first node is repeatedly unlinked while holding the sentinel and the
+ * node exclusively, so concurrent readers further down the list finish
+ * safely before the nodes they hold are deleted.
+ */
+template <typename T, unsigned Size>
+void ConcurrentBList<T, Size>::clear()
+{
+  for (;;)
+  {
+    std::unique_lock<Mutex> head_lock(head_.lock);
+    CNode *first = head_.next;
+    if (!first)
+      return;
+
+    std::unique_lock<Mutex> first_lock(first->lock);
+    head_.next = first->next;
+    item_count_ -= first->count;
+    --node_count_;
+    first_lock.unlock();
+    delete first;
+  }
+}
+
+/**
+ * @brief Get the statistics of the ConcurrentBList.
+ *
+ * @return BListStats The statistics, which may be stale if writers are active.
+ */
+template <typename T, unsigned Size>
+BListStats ConcurrentBList<T, Size>::GetStats() const
+{
+  return BListStats(sizeof(CNode), node_count_.load(), static_cast<int>(Size), item_count_.load());
+}
+
+/**
+ * @brief Creates a new, unlinked CNode.
+ *
+ * @return A pointer to the newly created CNode.
+ * @throws BListException if there is not enough memory to create the node.
+ */
+template <typename T, unsigned Size>
+typename ConcurrentBList<T, Size>::CNode *ConcurrentBList<T, Size>::createNode()
+{
+  auto new_node = new (std::nothrow) CNode;
+  if (!new_node)
+    throw BListException{
+        BListException::BLIST_EXCEPTION::E_NO_MEMORY, "Not enough memory to create a new node!"};
+  return new_node;
+}
+
+/**
+ * @brief Inserts a value at the specified index of a node with room for it.
+ *
+ * @param node The locked node in which the value will be inserted.
+ * @param index The index at which the value will be inserted.
+ * @param value The value to be inserted.
+ */
+template <typename T, unsigned Size>
+void ConcurrentBList<T, Size>::insertAtIndex(CNode *node, int index, const T &value)
+{
+  for (int i = node->count; i > index; --i)
+    node->values[i] = node->values[i - 1];
+  node->values[index] = value;
+  ++node->count;
+}
+
+/**
+ * @brief Splits a full node in half and inserts the value.
+ *
+ * The new node is filled before it is linked after the node, so only the
+ * node being split needs to be locked.
+ *
+ * @param node The locked, full node to be split.
+ * @param index The index at which to insert the value (may equal Size).
+ * @param value The value to be inserted.
+ */
+template <typename T, unsigned Size>
+void ConcurrentBList<T, Size>::splitNode(CNode *node, int index, const T &value)
+{
+  CNode *new_node = createNode();
+
+  if (Size == 1)
+  {
+    if (index == 0)
+    {
+      new_node->values[0] = node->values[0];
+      node->values[0] = value;
+    }
+    else
+      new_node->values[0] = value;
+    new_node->count = 1;
+  }
+  else
+  {
+    const int middle = static_cast<int>(Size) / 2;
+    for (int i = middle; i < node->count; ++i)
+      new_node->values[new_node->count++] = node->values[i];
+    node->count = middle;
+
+    if (index <= middle)
+      insertAtIndex(node, index, value);
+    else
+      insertAtIndex(new_node, index - middle, value);
+  }
+
+  new_node->next = node->next;
+  node->next = new_node;
+  ++node_count_;
+}
+
+/**
+ * @brief Finds the insertion index for a given value in a CNode.
+ *
+ * @param value The value to be inserted.
+ * @param node The locked CNode in which the value will be inserted.
+ * @return The index of the first item not less than the value.
+ */
+template <typename T, unsigned Size>
+int ConcurrentBList<T, Size>::findInsertionIndex(const T &value, const CNode *node) const
+{
+  int i = 0;
+  while (i < node->count && node->values[i] < value)
+    ++i;
+  return i;
+}
@@ -0,0 +1,90 @@
+/*!******************************************************************
+ * \file      ConcurrentBList.h
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course: CSD2183
+ * \par       Section: A
+ * \par
+ * \date      31-01-2024
+ *
+ * \brief     This file contains the declarations for the ConcurrentBList,
+ *            a sorted BList that can be shared between threads.
+ *********************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef CONCURRENTBLIST_H
+#define CONCURRENTBLIST_H
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>       // std::atomic
+#include <shared_mutex> // std::shared_timed_mutex
+#include "BList.h"      // BListException, BListStats
+
+/*!
+  A sorted BList that supports concurrent readers and writers.
+
+  Every node has its own reader/writer lock and all operations walk the list
+  from the head using hand-over-hand (lock coupling) locking: the next node
+  is locked before the current one is released. Readers (find, operator[])
+  take shared locks, so any number of them proceed in parallel. Writers
+  (insert, remove_by_value) take exclusive locks on at most two adjacent
+  nodes at a time, so a split only blocks readers at that point of the list.
+
+  Nodes are only linked forwards, which keeps every lock acquisition in
+  head-to-tail order and makes the locking deadlock free.
+*/
+template <typename T, unsigned Size = 1>
+class ConcurrentBList
+{
+public:
+  ConcurrentBList();  // default constructor
+  ~ConcurrentBList(); // destructor
+
+  // Shared lists are not copied
+  ConcurrentBList(const ConcurrentBList &rhs) = delete;
+  ConcurrentBList &operator=(const ConcurrentBList &rhs) = delete;
+
+  // arrays are kept sorted, nodes are split like BList::insert
+  void insert(const T &value);
+  void remove_by_value(const T &value);
+
+  int find(const T &value) const; // returns index, -1 if not found
+  T operator[](int index) const;  // by value, a reference could be invalidated by a writer
+
+  size_t size() const; // total number of items (not nodes)
+  void clear();        // delete all nodes
+
+  static size_t nodesize(); // so the allocator knows the size
+
+  BListStats GetStats() const;
+
+private:
+  typedef std::shared_timed_mutex Mutex; //!< per-node reader/writer lock
+
+  /*!
+    Node struct for the ConcurrentBList
+  */
+  struct CNode
+  {
+    CNode *next;        //!< pointer to next CNode
+    int count;          //!< number of items currently in the node
+    T values[Size];     //!< array of items in the node
+    mutable Mutex lock; //!< guards next, count and values
+
+    //!< Default constructor
+    CNode() : next(0), count(0) {}
+  };
+
+  CNode head_;                  //!< sentinel, never holds items
+  std::atomic<int> node_count_; //!< number of nodes (excluding the sentinel)
+  std::atomic<int> item_count_; //!< number of items in the list
+
+  CNode *createNode();
+  void insertAtIndex(CNode *node, int index, const T &value);
+  void splitNode(CNode *node, int index, const T &value);
+  int findInsertionIndex(const T &value, const CNode *node) const;
+};
+
+#include "ConcurrentBList.cpp"
+
+#endif // CONCURRENTBLIST_H
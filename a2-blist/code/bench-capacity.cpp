@@ -0,0 +1,228 @@
+/*!******************************************************************
+ * \file      bench-capacity.cpp
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course: CSD2183
+ * \par       Section: A
+ * \par
+ * \date      31-01-2024
+ *
+ * \brief     Times the BList push, insert, find and index workloads for
+ *            nodes that fill 1 to 32 cache lines and reports the fastest
+ *            for each workload. Each step is a CacheBList<int, Lines>, a
+ *            BList whose Size is picked by NodeSizeFor so that a node just
+ *            fits in Lines 64-byte cache lines; the Size and nodesize() are
+ *            printed with the timings.
+ *
+ *            Usage: bench-capacity [items] [lookups]
+ *********************************************************************/
+#include <chrono>   // std::chrono::steady_clock
+#include <cstdlib>  // std::atoi
+#include <iomanip>  // std::setw
+#include <iostream> // std::cout
+#include "BList.h"
+#include "PRNG.h"
+
+namespace
+{
+  const int Repeats = 3; //!< Best of this many runs is reported
+
+  //! The workloads being timed
+  enum Workload
+  {
+    W_PUSH,
+    W_INSERT,
+    W_FIND,
+    W_INDEX,
+    W_COUNT
+  };
+
+  const char *WorkloadNames[W_COUNT] = {"push", "insert", "find", "index"};
+
+  /*!
+    Shuffles an array using the course PRNG, like the sample driver.
+
+    \param array
+      The array to shuffle.
+
+    \param count
+      The number of items in the array.
+  */
+  void Shuffle(int *array, int count)
+  {
+    for (int i = 0; i < count; i++)
+    {
+      int r = Digipen::Utils::Random(i, count - 1);
+      int temp = array[i];
+      array[i] = array[r];
+      array[r] = temp;
+    }
+  }
+
+  /*!
+    Returns the time since a starting point in microseconds.
+
+    \param start
+      The starting point.
+
+    \return
+      The elapsed time.
+  */
+  double ElapsedMicros(std::chrono::steady_clock::time_point start)
+  {
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+  /*!
+    Times one workload at one node size.
+
+    \param workload
+      The workload to run.
+
+    \param keys
+      Shuffled keys, items of them.
+
+    \param items
+      The number of items in the list.
+
+    \param lookups
+      The number of find/index calls.
+
+    \return
+      The time taken in microseconds.
+  */
+  template <unsigned Size>
+  double TimeWorkload(Workload workload, const int *keys, int items, int lookups)
+  {
+    BList<int, Size> list;
+    long long sink = 0;
+
+    // find and index run on a sorted list built outside the timed region
+    if (workload == W_FIND || workload == W_INDEX)
+      for (int i = 0; i < items; i++)
+        list.insert(keys[i]);
+
+    auto start = std::chrono::steady_clock::now();
+    switch (workload)
+    {
+      case W_PUSH:
+        for (int i = 0; i < items; i++)
+          list.push_back(keys[i]);
+        break;
+      case W_INSERT:
+        for (int i = 0; i < items; i++)
+          list.insert(keys[i]);
+        break;
+      case W_FIND:
+        for (int i = 0; i < lookups; i++)
+          sink += list.find(keys[(i * 7919) % items]);
+        break;
+      case W_INDEX:
+        for (int i = 0; i < lookups; i++)
+          sink += list[keys[(i * 7919) % items]];
+        break;
+      default:
+        break;
+    }
+    double micros = ElapsedMicros(start);
+
+    // keep the lookups from being optimized away
+    if (sink == -1)
+      std::cout << "";
+    return micros;
+  }
+
+  //! Fastest time so far for each workload, with the node it was timed with
+  struct Best
+  {
+    double time[W_COUNT];
+    unsigned lines[W_COUNT];
+    unsigned size[W_COUNT];
+  };
+
+  //! Times every workload for a CacheBList of each number of cache lines in the list
+  template <unsigned... Lines>
+  struct CacheLines;
+
+  template <>
+  struct CacheLines<>
+  {
+    static void Run(const int *, int, int, Best &) {}
+  };
+
+  template <unsigned L, unsigned... Rest>
+  struct CacheLines<L, Rest...>
+  {
+    static void Run(const int *keys, int items, int lookups, Best &best)
+    {
+      const unsigned size = NodeSizeFor<int, L>::value;
+      std::cout << std::setw(6) << L << std::setw(6) << size
+                << std::setw(8) << CacheBList<int, L>::nodesize();
+      for (int w = 0; w < W_COUNT; w++)
+      {
+        double fastest = -1;
+        for (int r = 0; r < Repeats; r++)
+        {
+          double t = TimeWorkload<size>(static_cast<Workload>(w), keys, items, lookups);
+          if (fastest < 0 || t < fastest)
+            fastest = t;
+        }
+
+        if (best.time[w] < 0 || fastest < best.time[w])
+        {
+          best.time[w] = fastest;
+          best.lines[w] = L;
+          best.size[w] = size;
+        }
+        std::cout << std::setw(14) << std::fixed << std::setprecision(0) << fastest;
+      }
+      std::cout << std::endl;
+
+      CacheLines<Rest...>::Run(keys, items, lookups, best);
+    }
+  };
+}
+
+int main(int argc, char **argv)
+{
+  int items = argc > 1 ? std::atoi(argv[1]) : 10000;
+  int lookups = argc > 2 ? std::atoi(argv[2]) : 2000;
+  if (items < 1 || lookups < 1)
+  {
+    std::cout << "Usage: " << argv[0] << " [items] [lookups]\n";
+    return 1;
+  }
+
+  // keys 0..items-1, so they double as valid indices
+  int *keys = new int[items];
+  for (int i = 0; i < items; i++)
+    keys[i] = i;
+  Digipen::Utils::srand(0, 0);
+  Shuffle(keys, items);
+
+  std::cout << "items: " << items << ", lookups: " << lookups
+            << ", sizeof(int): " << sizeof(int) << ", times in microseconds\n\n";
+
+  std::cout << std::setw(6) << "lines" << std::setw(6) << "Size" << std::setw(8) << "bytes";
+  for (int w = 0; w < W_COUNT; w++)
+    std::cout << std::setw(14) << WorkloadNames[w];
+  std::cout << std::endl;
+
+  Best best;
+  for (int w = 0; w < W_COUNT; w++)
+  {
+    best.time[w] = -1;
+    best.lines[w] = 0;
+    best.size[w] = 0;
+  }
+  CacheLines<1, 2, 4, 8, 16, 32>::Run(keys, items, lookups, best);
+
+  std::cout << "\noptimum:" << std::endl;
+  for (int w = 0; w < W_COUNT; w++)
+    std::cout << std::setw(8) << WorkloadNames[w] << ": CacheBList<int, " << best.lines[w]
+              << "> (Size " << best.size[w] << ")" << std::endl;
+
+  delete[] keys;
+  return 0;
+}
@@ -0,0 +1,183 @@
+/*!******************************************************************
+ * \file      bench-concurrent.cpp
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course: CSD2183
+ * \par       Section: A
+ * \par
+ * \date      31-01-2024
+ *
+ * \brief     Times lookups on a sorted list shared by 1 to 8 reader
+ *            threads while one writer thread inserts and removes items,
+ *            for ConcurrentBList (per-node reader/writer locks) and for a
+ *            BList behind one big std::mutex. Reports the lookups per
+ *            millisecond of all readers together.
+ *
+ *            Usage: bench-concurrent [items] [lookups per reader]
+ *********************************************************************/
+#include <atomic>   // std::atomic
+#include <chrono>   // std::chrono::steady_clock
+#include <cstdlib>  // std::atoi
+#include <iomanip>  // std::setw
+#include <iostream> // std::cout
+#include <mutex>    // std::mutex, std::lock_guard
+#include <thread>   // std::thread
+#include <vector>   // std::vector
+#include "BList.h"
+#include "ConcurrentBList.h"
+
+namespace
+{
+  const unsigned NodeSize = 64; //!< Size of the nodes of both lists
+  const int Repeats = 3;        //!< Best of this many runs is reported
+
+  //! One BList shared behind a single lock, the baseline
+  struct LockedBList
+  {
+    BList<int, NodeSize> list; //!< the items
+    mutable std::mutex lock;   //!< guards every call
+
+    void insert(int value)
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      list.insert(value);
+    }
+
+    void remove_by_value(int value)
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      list.remove_by_value(value);
+    }
+
+    int find(int value) const
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      return list.find(value);
+    }
+  };
+
+  /*!
+    Returns the time since a starting point in milliseconds.
+
+    \param start
+      The starting point.
+
+    \return
+      The elapsed time.
+  */
+  double ElapsedMillis(std::chrono::steady_clock::time_point start)
+  {
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+  /*!
+    Runs the readers and the writer once on a freshly filled list.
+
+    \param readers
+      The number of reader threads.
+
+    \param items
+      The number of even values the list starts with.
+
+    \param lookups
+      The number of finds each reader makes.
+
+    \return
+      Lookups per millisecond of all readers together.
+  */
+  template <typename List>
+  double RunOnce(int readers, int items, int lookups)
+  {
+    List list;
+    for (int i = 0; i < items; i++)
+      list.insert(2 * i);
+
+    // The writer inserts and removes odd values until the readers are done
+    std::atomic<bool> done(false);
+    std::thread writer([&list, &done, items]() {
+      for (int i = 0; !done; i = (i + 1) % items)
+      {
+        list.insert(2 * i + 1);
+        list.remove_by_value(2 * i + 1);
+      }
+    });
+
+    std::atomic<long long> sink(0);
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < readers; r++)
+      threads.push_back(std::thread([&list, &sink, r, items, lookups]() {
+        long long found = 0;
+        for (int i = 0; i < lookups; i++)
+          found += list.find((i * 7919 + r * 104729) % (2 * items));
+        sink += found;
+      }));
+    for (auto &thread : threads)
+      thread.join();
+    double millis = ElapsedMillis(start);
+
+    done = true;
+    writer.join();
+
+    // keep the lookups from being optimized away
+    if (sink == -1)
+      std::cout << "";
+    return readers * static_cast<double>(lookups) / millis;
+  }
+
+  /*!
+    Returns the best of Repeats runs.
+
+    \param readers
+      The number of reader threads.
+
+    \param items
+      The number of items in the list.
+
+    \param lookups
+      The number of finds each reader makes.
+
+    \return
+      Lookups per millisecond of all readers together.
+  */
+  template <typename List>
+  double Run(int readers, int items, int lookups)
+  {
+    double best = 0;
+    for (int r = 0; r < Repeats; r++)
+    {
+      double rate = RunOnce<List>(readers, items, lookups);
+      if (rate > best)
+        best = rate;
+    }
+    return best;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int items = argc > 1 ? std::atoi(argv[1]) : 10000;
+  int lookups = argc > 2 ? std::atoi(argv[2]) : 2000;
+  if (items < 1 || lookups < 1)
+  {
+    std::cout << "Usage: " << argv[0] << " [items] [lookups per reader]\n";
+    return 1;
+  }
+
+  std::cout << "items: " << items << ", lookups per reader: " << lookups << ", node size: " << NodeSize
+            << ", hardware threads: " << std::thread::hardware_concurrency()
+            << ", one writer, lookups per ms\n\n";
+  std::cout << std::setw(8) << "readers" << std::setw(16) << "ConcurrentBList" << std::setw(16)
+            << "BList + mutex" << std::setw(10) << "ratio" << std::endl;
+
+  for (int readers = 1; readers <= 8; readers *= 2)
+  {
+    double concurrent = Run<ConcurrentBList<int, NodeSize>>(readers, items, lookups);
+    double locked = Run<LockedBList>(readers, items, lookups);
+    std::cout << std::setw(8) << readers << std::fixed << std::setprecision(0) << std::setw(16)
+              << concurrent << std::setw(16) << locked << std::setprecision(2) << std::setw(10)
+              << concurrent / locked << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,157 @@
+/*!******************************************************************
+ * \file      bench-find.cpp
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course: CSD2183
+ * \par       Section: A
+ * \par
+ * \date      31-01-2024
+ *
+ * \brief     Times BList::find, which scans each node with BListScan::find,
+ *            against the same walk using the one-at-a-time == loop, for
+ *            int and double lists with node sizes 16, 64 and 512.
+ *
+ *            Usage: bench-find [items] [lookups]
+ *********************************************************************/
+#include <chrono>   // std::chrono::steady_clock
+#include <cstdlib>  // std::atoi
+#include <iomanip>  // std::setw
+#include <iostream> // std::cout
+#include "BList.h"
+#include "PRNG.h"
+
+namespace
+{
+  const int Repeats = 3; //!< Best of this many runs is reported
+
+  /*!
+    The scalar baseline: BList::find with a plain == loop per node.
+
+    \param list
+      The list to search.
+
+    \param value
+      The value to search for.
+
+    \return
+      The index of the value, or -1 if not found.
+  */
+  template <typename T, unsigned Size>
+  int ScalarFind(const BList<T, Size> &list, const T &value)
+  {
+    int total_index = 0;
+    for (auto node = list.GetHead(); node; node = node->next)
+    {
+      int i = BListScan::findScalar(node->values, node->count, value);
+      if (i >= 0)
+        return total_index + i;
+      total_index += node->count;
+    }
+    return -1;
+  }
+
+  /*!
+    Times a number of lookups with either search.
+
+    \param list
+      The list to search.
+
+    \param keys
+      The values to look up, about half of them are not in the list.
+
+    \param lookups
+      The number of lookups.
+
+    \param vector
+      true for BList::find, false for the scalar baseline.
+
+    \return
+      The best time in microseconds.
+  */
+  template <typename T, unsigned Size>
+  double TimeFind(const BList<T, Size> &list, const T *keys, int lookups, bool vector)
+  {
+    double best = -1;
+    for (int r = 0; r < Repeats; r++)
+    {
+      long long sink = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < lookups; i++)
+        sink += vector ? list.find(keys[i]) : ScalarFind(list, keys[i]);
+      std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+      // keep the lookups from being optimized away
+      if (sink == 1)
+        std::cout << "";
+      if (best < 0 || elapsed.count() < best)
+        best = elapsed.count();
+    }
+    return best;
+  }
+
+  /*!
+    Builds a list and prints one row of results.
+
+    \param type
+      The name of the element type.
+
+    \param items
+      The number of items in the list.
+
+    \param lookups
+      The number of lookups.
+  */
+  template <typename T, unsigned Size>
+  void Run(const char *type, int items, int lookups)
+  {
+    BList<T, Size> list;
+    for (int i = 0; i < items; i++)
+      list.push_back(static_cast<T>(i));
+
+    T *keys = new T[lookups];
+    for (int i = 0; i < lookups; i++)
+      keys[i] = static_cast<T>(Digipen::Utils::Random(0, 2 * items - 1));
+
+    double scalar = TimeFind(list, keys, lookups, false);
+    double vector = TimeFind(list, keys, lookups, true);
+
+    std::cout << std::setw(8) << type << std::setw(6) << Size
+              << std::setw(14) << std::fixed << std::setprecision(0) << scalar
+              << std::setw(14) << vector
+              << std::setw(10) << std::setprecision(2) << scalar / vector << "x" << std::endl;
+
+    delete[] keys;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int items = argc > 1 ? std::atoi(argv[1]) : 100000;
+  int lookups = argc > 2 ? std::atoi(argv[2]) : 1000;
+  if (items < 1 || lookups < 1)
+  {
+    std::cout << "Usage: " << argv[0] << " [items] [lookups]\n";
+    return 1;
+  }
+
+  Digipen::Utils::srand(0, 0);
+#if defined(__AVX2__)
+  const char *isa = "AVX2";
+#elif defined(BLISTSCAN_SIMD)
+  const char *isa = "SSE2";
+#else
+  const char *isa = "none";
+#endif
+  std::cout << "items: " << items << ", lookups: " << lookups << ", vector ISA: " << isa
+            << ", times in microseconds\n\n";
+  std::cout << std::setw(8) << "type" << std::setw(6) << "Size"
+            << std::setw(14) << "scalar" << std::setw(14) << "vector" << std::setw(11) << "speedup" << std::endl;
+
+  Run<int, 16>("int", items, lookups);
+  Run<int, 64>("int", items, lookups);
+  Run<int, 512>("int", items, lookups);
+  Run<double, 16>("double", items, lookups);
+  Run<double, 64>("double", items, lookups);
+  Run<double, 512>("double", items, lookups);
+  return 0;
+}
@@ -0,0 +1,110 @@
+/*!******************************************************************
+ * \file      bench-insert.cpp
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course: CSD2183
+ * \par       Section: A
+ * \par
+ * \date      31-01-2024
+ *
+ * \brief     Times sorted BList::insert on the test3_* workloads of the
+ *            sample driver: a shuffled run of distinct values inserted
+ *            into an empty list, for node sizes 1 to 16, plus 64 and 512.
+ *
+ *            Usage: bench-insert [items] [rounds]
+ *********************************************************************/
+#include <chrono>   // std::chrono::steady_clock
+#include <cstdlib>  // std::atoi
+#include <iomanip>  // std::setw
+#include <iostream> // std::cout
+#include <vector>   // std::vector
+#include "BList.h"
+#include "PRNG.h"
+
+namespace
+{
+  const int Repeats = 3; //!< Best of this many runs is reported
+
+  /*!
+    Shuffles an array, as the sample driver does.
+
+    \param values
+      The array to shuffle.
+  */
+  void Shuffle(std::vector<int> &values)
+  {
+    for (size_t i = 0; i < values.size(); i++)
+    {
+      int r = Digipen::Utils::Random(0, static_cast<int>(values.size()) - 1);
+      std::swap(values[i], values[static_cast<size_t>(r)]);
+    }
+  }
+
+  /*!
+    Times building lists by sorted insertion and prints one row.
+
+    \param keys
+      The values to insert, in insertion order.
+
+    \param rounds
+      The number of lists built per run.
+  */
+  template <unsigned Size>
+  void Run(const std::vector<int> &keys, int rounds)
+  {
+    double best = -1;
+    for (int r = 0; r < Repeats; r++)
+    {
+      long long sink = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (int round = 0; round < rounds; round++)
+      {
+        BList<int, Size> list;
+        for (int key : keys)
+          list.insert(key);
+        sink += list.GetStats().NodeCount;
+      }
+      std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+      // keep the lists from being optimized away
+      if (sink == 1)
+        std::cout << "";
+      if (best < 0 || elapsed.count() < best)
+        best = elapsed.count();
+    }
+
+    std::cout << std::setw(6) << Size << std::setw(16) << std::fixed << std::setprecision(1)
+              << best / (static_cast<double>(rounds) * static_cast<double>(keys.size())) << std::endl;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int items = argc > 1 ? std::atoi(argv[1]) : 16;
+  int rounds = argc > 2 ? std::atoi(argv[2]) : 100000;
+  if (items < 1 || rounds < 1)
+  {
+    std::cout << "Usage: " << argv[0] << " [items] [rounds]\n";
+    return 1;
+  }
+
+  // values 11 to 10 + 4 * items, shuffled, the first items of them inserted
+  Digipen::Utils::srand(2, 1);
+  std::vector<int> keys(static_cast<size_t>(4 * items));
+  for (size_t i = 0; i < keys.size(); i++)
+    keys[i] = static_cast<int>(i) + 11;
+  Shuffle(keys);
+  keys.resize(static_cast<size_t>(items));
+
+  std::cout << "items: " << items << ", rounds: " << rounds << "\n\n";
+  std::cout << std::setw(6) << "Size" << std::setw(16) << "ns/insert" << std::endl;
+
+  Run<1>(keys, rounds);
+  Run<2>(keys, rounds);
+  Run<4>(keys, rounds);
+  Run<8>(keys, rounds);
+  Run<16>(keys, rounds);
+  Run<64>(keys, rounds);
+  Run<512>(keys, rounds);
+  return 0;
+}
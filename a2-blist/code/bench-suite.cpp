@@ -0,0 +1,327 @@
+/*!******************************************************************
+ * \file      bench-suite.cpp
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course: CSD2183
+ * \par       Section: A
+ * \par
+ * \date      31-01-2024
+ *
+ * \brief     Benchmark suite for BList. Times push_back, push_front,
+ *            sorted insert, find, operator[], remove by index and copy
+ *            for BList<int, Size> with Size 1 to 512, and for std::vector,
+ *            std::list and std::deque, over list lengths 1e3 upwards.
+ *
+ *            Each benchmark reports the best of several repetitions in
+ *            nanoseconds per operation. Operations that are linear in the
+ *            list length (insert, find, index, remove) run a fixed number
+ *            of times on a list that already holds the given number of
+ *            items; setup is not timed. Results can be written as CSV or
+ *            as JSON in the layout used by google-benchmark, so runs can
+ *            be compared to track regressions.
+ *
+ *            Usage: bench-suite [--max-items N] [--repeats R]
+ *                               [--filter text] [--csv file] [--json file]
+ *********************************************************************/
+#include <algorithm> // std::lower_bound, std::find
+#include <chrono>    // std::chrono::steady_clock
+#include <cstdlib>   // std::atoi, std::atof
+#include <cstring>   // std::strcmp
+#include <deque>     // std::deque
+#include <fstream>   // std::ofstream
+#include <iomanip>   // std::setw
+#include <iostream>  // std::cout
+#include <iterator>  // std::next, std::distance
+#include <list>      // std::list
+#include <sstream>   // std::ostringstream
+#include <string>    // std::string
+#include <vector>    // std::vector
+#include "BList.h"
+#include "PRNG.h"
+
+namespace
+{
+  const int LinearOps = 1000;               //!< operations timed for O(n) workloads
+  const int VectorPushFrontLimit = 100000;  //!< std::vector::insert(begin) is O(n)
+
+  //! One measurement
+  struct Result
+  {
+    std::string container; //!< e.g. "BList", "std::vector"
+    int node_size;         //!< BList Size, 0 for std containers
+    std::string workload;  //!< e.g. "insert"
+    int items;             //!< list length
+    int ops;               //!< operations per repetition
+    double ns_per_op;      //!< best time per operation
+  };
+
+  //! Command-line options
+  struct Options
+  {
+    int max_items;       //!< largest list length
+    int repeats;         //!< repetitions per benchmark
+    std::string filter;  //!< only run benchmarks whose name contains this
+    std::string csv;     //!< CSV output file, empty for none
+    std::string json;    //!< JSON output file, empty for none
+  };
+
+  std::vector<Result> Results; //!< everything measured so far
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Container adapters: the same operation for BList and the std containers
+
+  template <typename T, unsigned S>
+  void PushFront(BList<T, S> &c, const T &v) { c.push_front(v); }
+  template <typename C>
+  void PushFront(C &c, const typename C::value_type &v) { c.insert(c.begin(), v); }
+
+  template <typename T, unsigned S>
+  void InsertSorted(BList<T, S> &c, const T &v) { c.insert(v); }
+  template <typename C>
+  void InsertSorted(C &c, const typename C::value_type &v) { c.insert(std::lower_bound(c.begin(), c.end(), v), v); }
+
+  template <typename T, unsigned S>
+  int Find(const BList<T, S> &c, const T &v) { return c.find(v); }
+  template <typename C>
+  int Find(const C &c, const typename C::value_type &v)
+  {
+    auto it = std::find(c.begin(), c.end(), v);
+    return it == c.end() ? -1 : static_cast<int>(std::distance(c.begin(), it));
+  }
+
+  template <typename T, unsigned S>
+  const T &At(const BList<T, S> &c, int i) { return c[i]; }
+  template <typename C>
+  const typename C::value_type &At(const C &c, int i) { return c[static_cast<size_t>(i)]; }
+  template <typename T>
+  const T &At(const std::list<T> &c, int i) { return *std::next(c.begin(), i); }
+
+  template <typename T, unsigned S>
+  void RemoveAt(BList<T, S> &c, int i) { c.remove(i); }
+  template <typename C>
+  void RemoveAt(C &c, int i) { c.erase(std::next(c.begin(), i)); }
+
+  template <typename T, unsigned S>
+  void FillSorted(BList<T, S> &c, const std::vector<T> &v) { c.build_from_sorted(v.begin(), v.end()); }
+  template <typename C>
+  void FillSorted(C &c, const std::vector<typename C::value_type> &v) { c.assign(v.begin(), v.end()); }
+
+  template <typename C>
+  int NodeSize(const C &) { return 0; }
+  template <typename T, unsigned S>
+  int NodeSize(const BList<T, S> &) { return static_cast<int>(S); }
+
+  ////////////////////////////////////////////////////////////////////////////
+
+  /*!
+    Returns the time since a starting point in nanoseconds.
+
+    \param start
+      The starting point.
+
+    \return
+      The elapsed time.
+  */
+  double ElapsedNanos(std::chrono::steady_clock::time_point start)
+  {
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+  /*!
+    Runs every workload for one container type and list length.
+
+    \param name
+      The name of the container for the report.
+
+    \param items
+      The list length.
+
+    \param options
+      The command-line options.
+  */
+  template <typename C>
+  void RunContainer(const char *name, int items, const Options &options)
+  {
+    const char *workloads[] = {"push_back", "push_front", "insert", "find", "index", "remove", "copy"};
+    const int linear_ops = items < LinearOps ? items : LinearOps;
+
+    // Keys are random in [0, 4 * items); sorted is the list for the O(n) workloads
+    Digipen::Utils::srand(1, 2);
+    std::vector<int> keys(static_cast<size_t>(items));
+    for (auto &key : keys)
+      key = Digipen::Utils::Random(0, 4 * items - 1);
+    std::vector<int> sorted(keys);
+    std::sort(sorted.begin(), sorted.end());
+
+    for (const char *workload : workloads)
+    {
+      C prototype;
+      std::ostringstream label;
+      label << name;
+      if (NodeSize(prototype))
+        label << "<int," << NodeSize(prototype) << ">";
+      label << "/" << workload << "/" << items;
+      if (label.str().find(options.filter) == std::string::npos)
+        continue;
+
+      const std::string w = workload;
+      if (w == "push_front" && NodeSize(prototype) == 0 && std::string(name) == "std::vector" &&
+          items > VectorPushFrontLimit)
+        continue;
+
+      int ops = (w == "push_back" || w == "push_front") ? items : w == "copy" ? 1 : linear_ops;
+      double best = -1;
+      long long sink = 0;
+
+      for (int r = 0; r < options.repeats; r++)
+      {
+        C c;
+        if (w != "push_back" && w != "push_front")
+          FillSorted(c, sorted);
+
+        auto start = std::chrono::steady_clock::now();
+        if (w == "push_back")
+          for (int i = 0; i < ops; i++)
+            c.push_back(keys[static_cast<size_t>(i)]);
+        else if (w == "push_front")
+          for (int i = 0; i < ops; i++)
+            PushFront(c, keys[static_cast<size_t>(i)]);
+        else if (w == "insert")
+          for (int i = 0; i < ops; i++)
+            InsertSorted(c, keys[static_cast<size_t>(i)]);
+        else if (w == "find")
+          for (int i = 0; i < ops; i++)
+            sink += Find(c, keys[static_cast<size_t>(i)]);
+        else if (w == "index")
+          for (int i = 0; i < ops; i++)
+            sink += At(c, keys[static_cast<size_t>(i)] % items);
+        else if (w == "remove")
+          for (int i = 0; i < ops; i++)
+            RemoveAt(c, keys[static_cast<size_t>(i)] % (items - i));
+        else
+        {
+          C copy(c);
+          sink += static_cast<long long>(copy.size());
+        }
+        double ns = ElapsedNanos(start) / ops;
+        if (best < 0 || ns < best)
+          best = ns;
+      }
+
+      // keep the lookups from being optimized away
+      if (sink == -1)
+        std::cout << "";
+
+      Result result = {name, NodeSize(prototype), workload, items, ops, best};
+      Results.push_back(result);
+      std::cout << std::left << std::setw(40) << label.str() << std::right
+                << std::setw(14) << std::fixed << std::setprecision(1) << best << " ns/op"
+                << std::setw(10) << ops << " ops" << std::endl;
+    }
+  }
+
+  //! Runs BList for each node size in the list
+  template <unsigned... Sizes>
+  struct BListSizes;
+
+  template <>
+  struct BListSizes<>
+  {
+    static void Run(int, const Options &) {}
+  };
+
+  template <unsigned S, unsigned... Rest>
+  struct BListSizes<S, Rest...>
+  {
+    static void Run(int items, const Options &options)
+    {
+      RunContainer<BList<int, S>>("BList", items, options);
+      BListSizes<Rest...>::Run(items, options);
+    }
+  };
+
+  /*!
+    Writes the results as CSV.
+
+    \param path
+      The output file.
+  */
+  void WriteCsv(const std::string &path)
+  {
+    std::ofstream out(path);
+    out << "container,node_size,workload,items,ops,ns_per_op\n";
+    for (const auto &r : Results)
+      out << r.container << "," << r.node_size << "," << r.workload << "," << r.items << ","
+          << r.ops << "," << r.ns_per_op << "\n";
+  }
+
+  /*!
+    Writes the results as JSON in the layout of google-benchmark's
+    --benchmark_format=json, with extra fields for the parameters.
+
+    \param path
+      The output file.
+  */
+  void WriteJson(const std::string &path)
+  {
+    std::ofstream out(path);
+    out << "{\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < Results.size(); i++)
+    {
+      const auto &r = Results[i];
+      std::ostringstream name;
+      name << r.container;
+      if (r.node_size)
+        name << "<int," << r.node_size << ">";
+      name << "/" << r.workload << "/" << r.items;
+
+      out << "    {\"name\": \"" << name.str() << "\", \"container\": \"" << r.container
+          << "\", \"node_size\": " << r.node_size << ", \"workload\": \"" << r.workload
+          << "\", \"items\": " << r.items << ", \"iterations\": " << r.ops
+          << ", \"real_time\": " << r.ns_per_op << ", \"time_unit\": \"ns\"}"
+          << (i + 1 < Results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+  }
+}
+
+int main(int argc, char **argv)
+{
+  Options options = {100000, 3, "", "", ""};
+  for (int i = 1; i < argc; i++)
+  {
+    if (!std::strcmp(argv[i], "--max-items") && i + 1 < argc)
+      options.max_items = static_cast<int>(std::atof(argv[++i]));
+    else if (!std::strcmp(argv[i], "--repeats") && i + 1 < argc)
+      options.repeats = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--filter") && i + 1 < argc)
+      options.filter = argv[++i];
+    else if (!std::strcmp(argv[i], "--csv") && i + 1 < argc)
+      options.csv = argv[++i];
+    else if (!std::strcmp(argv[i], "--json") && i + 1 < argc)
+      options.json = argv[++i];
+    else
+    {
+      std::cout << "Usage: " << argv[0]
+                << " [--max-items N] [--repeats R] [--filter text] [--csv file] [--json file]\n";
+      return 1;
+    }
+  }
+  if (options.repeats < 1)
+    options.repeats = 1;
+
+  for (int items = 1000; items <= options.max_items; items *= 10)
+  {
+    BListSizes<1, 2, 4, 8, 16, 32, 64, 128, 256, 512>::Run(items, options);
+    RunContainer<std::vector<int>>("std::vector", items, options);
+    RunContainer<std::deque<int>>("std::deque", items, options);
+    RunContainer<std::list<int>>("std::list", items, options);
+  }
+
+  if (!options.csv.empty())
+    WriteCsv(options.csv);
+  if (!options.json.empty())
+    WriteJson(options.json);
+  return 0;
+}
@@ -1,9 +1,19 @@
 #include <iostream>
 #include <iomanip>
 #include "BList.h"
+#include "BListImage.h"
+#include "ConcurrentBList.h"
 #include "PRNG.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 int RandomInt(int low, int high)
 {
@@ -58,6 +68,7 @@ template <typename T, unsigned Size>
 void DumpList(const BList<T, Size>& blist, bool flat = false)
 {
   const typename BList<T, Size>::BNode *node = blist.GetHead();
+  unsigned offset = static_cast<unsigned>(blist.head_offset()); // deque mode only
   unsigned count = 0;
   if (flat)
     std::cout << "List: ";
@@ -68,12 +79,13 @@ void DumpList(const BList<T, Size>& blist, bool flat = false)
 
     for (unsigned i = 0; i < node->count; i++)
     {
-      std::cout << node->values[i] << " ";
+      std::cout << node->values[offset + i] << " ";
     }
 
     if (!flat)
       std::cout << std::endl;
     node = node->next;
+    offset = 0;
   }
   std::cout << std::endl;
 }
@@ -82,13 +94,15 @@ template <typename T, unsigned Size>
 void DumpListFlat(const BList<T, Size>& blist)
 {
   const typename BList<T, Size>::BNode *node = blist.GetHead();
+  unsigned offset = static_cast<unsigned>(blist.head_offset()); // deque mode only
   while (node)
   {
     for (unsigned i = 0; i < node->count; i++)
     {
-      std::cout << node->values[i] << " ";
+      std::cout << node->values[offset + i] << " ";
     }
     node = node->next;
+    offset = 0;
   }
 }
 
@@ -1653,6 +1667,803 @@ void testD()
 
 }
 
+// deque mode: positional insert/erase after pop_front left a gap in the head
+void testE()
+{
+  std::cout << "===== deque mode: insert/erase next to the head =====\n";
+  const unsigned asize = 4;
+
+  BList<int, asize> bl;
+  bl.set_deque_mode(true);
+  for (int i = 0; i < 8; i++)
+    bl.push_back(i);
+  DumpList(bl, false);
+
+  // slot 0 of the full second node, the head gets room in front
+  BList<int, asize>::iterator it = bl.begin();
+  for (int i = 0; i < 4; i++)
+    ++it;
+  bl.pop_front();
+  it = bl.insert(it, 99);
+  std::cout << "Inserted " << *it << std::endl;
+  DumpList(bl, false);
+
+  bl.pop_front();
+  it = bl.begin();
+  ++it;
+  it = bl.erase(it);
+  std::cout << "Next is " << *it << std::endl;
+  DumpList(bl, false);
+  DumpStats(bl);
+
+  std::cout << std::endl;
+}
+
+// iterators: traversal both ways, range-for, positional insert/erase
+void testF()
+{
+  std::cout << "===== iterators: traversal, insert(it, v), erase(it) =====\n";
+  const unsigned asize = 4;
+
+  BList<int, asize> bl;
+  std::cout << "empty: begin() == end() is " << (bl.begin() == bl.end()) << std::endl;
+  for (int i = 0; i < 10; i++)
+    bl.push_back(i);
+  DumpList(bl, false);
+
+  std::cout << "Forward: ";
+  for (BList<int, asize>::iterator it = bl.begin(); it != bl.end(); ++it)
+    std::cout << *it << " ";
+  std::cout << std::endl;
+
+  std::cout << "Backward: ";
+  for (BList<int, asize>::iterator it = bl.end(); it != bl.begin();)
+    std::cout << *--it << " ";
+  std::cout << std::endl;
+
+  const BList<int, asize> &cbl = bl;
+  std::cout << "Range-for (const): ";
+  for (const int &value : cbl)
+    std::cout << value << " ";
+  std::cout << std::endl;
+
+  BList<int, asize>::const_iterator last = cbl.end();
+  --last;
+  std::cout << "*--end(): " << *last << std::endl;
+  std::cout << "distance: " << std::distance(cbl.cbegin(), cbl.cend()) << std::endl;
+  std::cout << "find 6 at: " << std::distance(cbl.begin(), std::find(cbl.begin(), cbl.end(), 6)) << std::endl;
+
+  // post-increment/decrement return the old position
+  BList<int, asize>::iterator it = bl.begin();
+  std::cout << "it++: " << *it++ << ", then " << *it << std::endl;
+  std::cout << "it--: " << *it-- << ", then " << *it << std::endl;
+
+  // writing through an iterator
+  for (int &value : bl)
+    value *= 10;
+  DumpList(bl, false);
+
+  // insert(it, v) returns the new item; the one it was inserted before follows it
+  it = bl.insert(bl.begin(), -5);
+  std::cout << "Inserted " << *it << " at " << std::distance(bl.begin(), it)
+            << ", next is " << *std::next(it) << std::endl;
+  DumpList(bl, false);
+
+  it = bl.begin();
+  std::advance(it, 6);
+  it = bl.insert(it, 45);
+  std::cout << "Inserted " << *it << " at " << std::distance(bl.begin(), it)
+            << ", next is " << *std::next(it) << std::endl;
+  DumpList(bl, false);
+
+  it = bl.insert(bl.end(), 100);
+  std::cout << "Inserted " << *it << " at " << std::distance(bl.begin(), it)
+            << ", next is end: " << (std::next(it) == bl.end()) << std::endl;
+  DumpList(bl, false);
+
+  // erase(it) returns the item that followed the erased one
+  it = bl.erase(bl.begin());
+  std::cout << "Erased first, next is " << *it << " at " << std::distance(bl.begin(), it) << std::endl;
+  it = bl.end();
+  --it;
+  it = bl.erase(it);
+  std::cout << "Erased last, next is end: " << (it == bl.end()) << std::endl;
+  DumpList(bl, false);
+
+  // erase every item that is a multiple of 20
+  for (it = bl.begin(); it != bl.end();)
+  {
+    if (*it % 20 == 0)
+      it = bl.erase(it);
+    else
+      ++it;
+  }
+  DumpList(bl, false);
+  DumpStats(bl);
+
+  std::cout << std::endl;
+}
+
+// rebalancing on removal: under-full nodes borrow from or merge with a neighbour
+void testG()
+{
+  std::cout << "===== rebalancing on remove: node count and fill factor =====\n";
+  const unsigned asize = 8;
+
+  BList<int, asize> plain;
+  BList<int, asize> balanced;
+  balanced.set_rebalance(true);
+  std::cout << "rebalancing: " << plain.rebalancing() << " " << balanced.rebalancing() << std::endl;
+  for (int i = 0; i < 48; i++)
+  {
+    plain.push_back(i);
+    balanced.push_back(i);
+  }
+
+  // remove every other item each round, from the back so the indices stay valid
+  for (int round = 1; round <= 2; round++)
+  {
+    for (int i = static_cast<int>(plain.size()) - 1; i >= 0; i -= 2)
+    {
+      plain.remove(i);
+      balanced.remove(i);
+    }
+
+    BListStats p = plain.GetStats();
+    BListStats b = balanced.GetStats();
+    std::cout << "Round " << round << ": items " << p.ItemCount << std::setprecision(3)
+              << ", plain nodes " << p.NodeCount << " fill " << p.FillFactor()
+              << ", rebalanced nodes " << b.NodeCount << " fill " << b.FillFactor() << std::endl;
+  }
+  DumpList(plain, false);
+  DumpList(balanced, false);
+
+  // remove_by_value rebalances too: the first node drops below half and takes in the next
+  const int values[] = {0, 4, 8, 1000};
+  for (int value : values)
+  {
+    balanced.remove_by_value(value);
+    std::cout << "remove_by_value(" << value << "):" << std::endl;
+    DumpList(balanced, false);
+  }
+  std::cout << "Fill factor: " << balanced.GetStats().FillFactor() << std::endl;
+
+  // the same removals without rebalancing only free empty nodes
+  while (plain.size() > 1)
+    plain.remove(0);
+  DumpList(plain, false);
+  while (balanced.size() > 1)
+    balanced.remove(0);
+  DumpList(balanced, false);
+  balanced.remove(0);
+  std::cout << "Empty fill factor: " << balanced.GetStats().FillFactor() << std::endl;
+  DumpStats(balanced);
+
+  std::cout << std::endl;
+}
+
+// bulk loading: range constructor, append, assign, build_from_sorted
+void testH()
+{
+  std::cout << "===== bulk loading: append, assign, build_from_sorted =====\n";
+  const unsigned asize = 4;
+
+  std::vector<int> values;
+  for (int i = 0; i < 10; i++)
+    values.push_back(i * 3 % 10);
+
+  BList<int, asize> bl(values.begin(), values.end());
+  std::cout << "Range constructor:" << std::endl;
+  DumpList(bl, false);
+  DumpStats(bl);
+
+  // the tail's free slots are used before new nodes are made
+  const int more[] = {10, 11, 12, 13, 14, 15, 16};
+  bl.append(more, more + 7);
+  std::cout << "append 7:" << std::endl;
+  DumpList(bl, false);
+  bl.append(more, more);
+  std::cout << "append nothing, size " << bl.size() << std::endl;
+
+  // single-pass input iterators work too
+  std::istringstream input("20 21 22");
+  bl.append(std::istream_iterator<int>(input), std::istream_iterator<int>());
+  std::cout << "append from a stream:" << std::endl;
+  DumpList(bl, false);
+  DumpStats(bl);
+
+  bl.assign(more + 2, more + 7);
+  std::cout << "assign 5:" << std::endl;
+  DumpList(bl, false);
+
+  // sorted input gives full nodes, and insert keeps the list sorted afterwards
+  const int sorted[] = {1, 2, 2, 3, 5, 8, 8, 13, 21};
+  bl.build_from_sorted(sorted, sorted + 9);
+  std::cout << "build_from_sorted 9:" << std::endl;
+  DumpList(bl, false);
+  bl.insert(4);
+  bl.insert(9);
+  std::cout << "insert 4 and 9, find(9) is " << bl.find(9) << std::endl;
+  DumpList(bl, false);
+
+  // unsorted input is rejected and leaves the list empty
+  try
+  {
+    bl.build_from_sorted(values.begin(), values.end());
+    std::cout << "No exception!" << std::endl;
+  }
+  catch (const BListException &e)
+  {
+    std::cout << "Caught BListException, code " << e.code() << ": " << e.what()
+              << " (E_DATA_ERROR is " << BListException::E_DATA_ERROR << ")" << std::endl;
+  }
+  std::cout << "size after the throw: " << bl.size() << std::endl;
+  DumpStats(bl);
+
+  bl.build_from_sorted(sorted, sorted);
+  std::cout << "build_from_sorted of nothing, size " << bl.size() << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ConcurrentBList: writers and readers on separate threads
+void testI()
+{
+  std::cout << "===== ConcurrentBList: concurrent insert/remove_by_value/find =====\n";
+  const unsigned asize = 8;
+  const int count = 2000;
+
+  // even values to start with
+  ConcurrentBList<int, asize> list;
+  for (int i = 0; i < count; i += 2)
+    list.insert(i);
+  std::cout << "Before: " << list.size() << " items" << std::endl;
+
+  // writers 0-3 insert the odd values, writers 0-1 also remove multiples of 4;
+  // readers look for the evens that are never removed, which must always be found
+  std::atomic<int> missed(0);
+  std::atomic<bool> done(false);
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; r++)
+    readers.push_back(std::thread([&list, &missed, &done, r]() {
+      for (int i = 0; !done || i < count; i++)
+      {
+        int value = (4 * (i + r * 97) + 2) % count;
+        if (list.find(value) < 0)
+          ++missed;
+        list[i % 500];
+      }
+    }));
+
+  std::vector<std::thread> writers;
+  for (int w = 0; w < 4; w++)
+    writers.push_back(std::thread([&list, w]() {
+      for (int value = 2 * w + 1; value < count; value += 8)
+        list.insert(value);
+      if (w < 2)
+        for (int value = 4 * w; value < count; value += 8)
+          list.remove_by_value(value);
+    }));
+
+  for (auto &writer : writers)
+    writer.join();
+  done = true;
+  for (auto &reader : readers)
+    reader.join();
+
+  int expected = count - count / 4;
+  std::cout << "After: " << list.size() << " items, expected " << expected << std::endl;
+  std::cout << "Missed lookups: " << missed << std::endl;
+
+  bool sorted = true;
+  for (int i = 1; i < static_cast<int>(list.size()); i++)
+    if (list[i] < list[i - 1])
+      sorted = false;
+  std::cout << "Sorted: " << (sorted ? "yes" : "no") << std::endl;
+  std::cout << "find(0) " << list.find(0) << ", find(1) " << list.find(1) << ", find(2) "
+            << list.find(2) << ", find(1999) " << list.find(1999) << std::endl;
+
+  BListStats stats = list.GetStats();
+  std::cout << "Stats items: " << stats.ItemCount << ", nodes hold them: "
+            << (stats.NodeCount * stats.ArraySize >= stats.ItemCount) << std::endl;
+
+  try
+  {
+    list[expected];
+    std::cout << "No exception!" << std::endl;
+  }
+  catch (const BListException &e)
+  {
+    std::cout << "Caught BListException, code " << e.code() << ": " << e.what() << std::endl;
+  }
+
+  list.clear();
+  std::cout << "After clear: " << list.size() << " items, find(2) " << list.find(2) << std::endl;
+
+  std::cout << std::endl;
+}
+
+// splice, split_at and merge, including the edge cases and mismatched capacities
+void testJ()
+{
+  std::cout << "===== splice, split_at and merge =====\n";
+  const unsigned asize = 4;
+
+  BList<int, asize> bl;
+  for (int i = 0; i < 10; i++)
+    bl.push_back(i * 2);
+
+  // splicing into an empty list takes over the whole chain
+  BList<int, asize> empty;
+  empty.splice(bl);
+  std::cout << "splice into an empty list, source size " << bl.size() << ":" << std::endl;
+  DumpList(empty, false);
+  DumpStats(empty);
+
+  // split in the middle of a node, then put it back together
+  BList<int, asize> rest;
+  empty.split_at(5, rest);
+  std::cout << "split_at(5):" << std::endl;
+  DumpList(empty, false);
+  DumpList(rest, false);
+  empty.splice(rest);
+  std::cout << "splice back, rest size " << rest.size() << ":" << std::endl;
+  DumpList(empty, false);
+  DumpStats(empty);
+
+  // splitting at size() moves nothing, splitting at 0 moves everything
+  rest.push_back(99);
+  empty.split_at(static_cast<int>(empty.size()), rest);
+  std::cout << "split_at(size()): " << empty.size() << " and " << rest.size() << " items" << std::endl;
+  empty.split_at(0, rest);
+  std::cout << "split_at(0): " << empty.size() << " and " << rest.size() << " items" << std::endl;
+  DumpList(rest, false);
+  DumpStats(empty);
+
+  // merge of interleaved values, the odd values go in between
+  BList<int, asize> odd;
+  for (int i = 0; i < 10; i++)
+    odd.push_back(i * 2 + 1);
+  odd.push_back(30);
+  rest.merge(odd);
+  std::cout << "merge interleaved, other size " << odd.size() << ":" << std::endl;
+  DumpList(rest, false);
+  DumpStats(rest);
+
+  // merging an empty list changes nothing
+  rest.merge(odd);
+  std::cout << "merge of an empty list, size " << rest.size() << std::endl;
+
+  try
+  {
+    rest.split_at(static_cast<int>(rest.size()) + 1, odd);
+    std::cout << "No exception!" << std::endl;
+  }
+  catch (const BListException &e)
+  {
+    std::cout << "split_at(size() + 1): caught BListException, code " << e.code() << ": "
+              << e.what() << std::endl;
+  }
+
+  // nodes filled to 4 cannot be linked into a list that fills them to 2
+  BList<int, asize> small(2);
+  small.push_back(1);
+  BList<int, asize> big;
+  for (int i = 0; i < 6; i++)
+    big.push_back(i);
+  try
+  {
+    small.splice(big);
+    std::cout << "No exception!" << std::endl;
+  }
+  catch (const BListException &e)
+  {
+    std::cout << "splice: caught BListException, code " << e.code() << ": " << e.what()
+              << " (E_DATA_ERROR is " << BListException::E_DATA_ERROR << ")" << std::endl;
+  }
+  try
+  {
+    small.merge(big);
+    std::cout << "No exception!" << std::endl;
+  }
+  catch (const BListException &e)
+  {
+    std::cout << "merge: caught BListException, code " << e.code() << ": " << e.what() << std::endl;
+  }
+  std::cout << "sizes after the throws: " << small.size() << " and " << big.size() << std::endl;
+
+  // the other way round is fine: smaller nodes fit in bigger ones
+  big.splice(small);
+  std::cout << "splice the 2-item nodes into the 4-item list:" << std::endl;
+  DumpList(big, false);
+  DumpStats(big);
+
+  std::cout << std::endl;
+}
+
+// binary images: save/load, BListView header checks, BListImage over a file
+void testK()
+{
+  std::cout << "===== binary images: save, load, BListView, BListImage =====\n";
+  const unsigned asize = 4;
+
+  BList<int, asize> bl;
+  for (int i = 0; i < 10; i++)
+    bl.push_back(i * 3 % 10);
+
+  // round trip through a stream, into a list with a different node size
+  std::stringstream stream;
+  bl.save(stream);
+  BList<int, 8> copy;
+  copy.load(stream);
+  std::cout << "load into nodes of 8:" << std::endl;
+  DumpList(copy, false);
+  DumpStats(copy);
+
+  // a view needs the image in memory aligned for the items
+  const std::string image = stream.str();
+  std::vector<std::uint64_t> buffer((image.size() + 7) / 8);
+  std::memcpy(buffer.data(), image.data(), image.size());
+
+  BListView<int> view(buffer.data(), image.size());
+  std::cout << "view: size " << view.size() << ", array_size " << view.array_size()
+            << ", find(7) " << view.find(7) << ", find(10) " << view.find(10) << ", [9] " << view[9]
+            << std::endl;
+  std::cout << "items:";
+  for (int value : view)
+    std::cout << " " << value;
+  std::cout << std::endl;
+
+  // bad magic, a truncated image and the wrong item type are all rejected
+  std::vector<std::uint64_t> bad(buffer);
+  reinterpret_cast<char *>(bad.data())[0] = 'X';
+  try
+  {
+    BListView<int> broken(bad.data(), image.size());
+    std::cout << "No exception!" << std::endl;
+  }
+  catch (const BListException &e)
+  {
+    std::cout << "bad magic: caught BListException, code " << e.code() << ": " << e.what()
+              << std::endl;
+  }
+  try
+  {
+    BListView<int> broken(buffer.data(), image.size() - sizeof(int));
+    std::cout << "No exception!" << std::endl;
+  }
+  catch (const BListException &e)
+  {
+    std::cout << "truncated: caught BListException, code " << e.code() << ": " << e.what()
+              << std::endl;
+  }
+  try
+  {
+    BListView<short> broken(buffer.data(), image.size());
+    std::cout << "No exception!" << std::endl;
+  }
+  catch (const BListException &e)
+  {
+    std::cout << "item size: caught BListException, code " << e.code() << ": " << e.what()
+              << std::endl;
+  }
+  try
+  {
+    view[10];
+    std::cout << "No exception!" << std::endl;
+  }
+  catch (const BListException &e)
+  {
+    std::cout << "view[10]: caught BListException, code " << e.code() << ": " << e.what()
+              << std::endl;
+  }
+
+  // load of a truncated stream leaves the list empty
+  std::stringstream cut(image.substr(0, image.size() - sizeof(int)));
+  try
+  {
+    copy.load(cut);
+    std::cout << "No exception!" << std::endl;
+  }
+  catch (const BListException &e)
+  {
+    std::cout << "load truncated: caught BListException, code " << e.code() << ": " << e.what()
+              << ", size " << copy.size() << std::endl;
+  }
+
+  // the same image mapped from a file
+  const char *path = "testK-image.bin";
+  {
+    std::ofstream file(path, std::ios::binary);
+    bl.save(file);
+  }
+  {
+    BListImage<int> mapped(path);
+    const BListView<int> &items = mapped.view();
+    std::cout << "mapped: size " << items.size() << ", find(7) " << items.find(7) << ", [0] "
+              << items[0] << ", same items " << std::equal(items.begin(), items.end(), view.begin())
+              << std::endl;
+  }
+  std::remove(path);
+  try
+  {
+    BListImage<int> missing(path);
+    std::cout << "No exception!" << std::endl;
+  }
+  catch (const BListException &e)
+  {
+    std::cout << "missing file: caught BListException, code " << e.code() << ": " << e.what()
+              << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+// prints the items through the non-const operator[] (which moves the lookup
+// cursor), starting at a middle index, and checks them against the iterators
+template <typename T, unsigned Size>
+void print_cursor_scan(BList<T, Size> &list, const char *label)
+{
+  std::vector<T> items(list.cbegin(), list.cend());
+  int count = static_cast<int>(list.size());
+  bool same = true;
+  for (int i = count / 2; i < count; i++)
+    same = same && list[i] == items[static_cast<size_t>(i)];
+  std::cout << label << ":";
+  for (int i = 0; i < count; i++)
+  {
+    same = same && list[i] == items[static_cast<size_t>(i)];
+    std::cout << " " << list[i];
+  }
+  std::cout << (same ? "" : "  MISMATCH") << std::endl;
+}
+
+// lookup cursor: indexing between calls that restructure the nodes
+void testL()
+{
+  std::cout << "===== lookup cursor: operator[] between modifications =====\n";
+  const unsigned asize = 4;
+
+  BList<int, asize> bl;
+  for (int i = 0; i < 12; i++)
+    bl.insert(i * 2);
+  print_cursor_scan(bl, "insert 12 ");
+
+  // the cursor is left on a later node each time before the list changes
+  bl[9];
+  bl.insert(5);
+  print_cursor_scan(bl, "insert 5  ");
+  bl[10];
+  bl.insert(23);
+  print_cursor_scan(bl, "insert 23 ");
+
+  bl[11];
+  bl.remove(1);
+  print_cursor_scan(bl, "remove(1) ");
+  bl[8];
+  bl.remove_by_value(14);
+  print_cursor_scan(bl, "remove 14 ");
+
+  // splice and sort move every node behind the cursor
+  BList<int, asize> other;
+  for (int i = 0; i < 6; i++)
+    other.push_back(i * 7 % 6 + 100 - i * 40);
+  other[4];
+  bl[11];
+  bl.splice(other);
+  print_cursor_scan(bl, "splice    ");
+  bl[15];
+  bl.sort();
+  print_cursor_scan(bl, "sort      ");
+
+  // values written through operator[] land in the right place
+  bl[3] = -1;
+  bl[16] = -2;
+  bl[0] = -3;
+  print_cursor_scan(bl, "write     ");
+
+  bl[10];
+  bl.clear();
+  std::cout << "clear, size " << bl.size() << std::endl;
+  for (int i = 0; i < 16; i++)
+    bl.push_back(i * 5 % 16);
+  print_cursor_scan(bl, "push 16   ");
+
+  try
+  {
+    bl[16];
+    std::cout << "No exception!" << std::endl;
+  }
+  catch (const BListException &e)
+  {
+    std::cout << "Caught BListException, code " << e.code() << ": " << e.what() << std::endl;
+  }
+  DumpList(bl, false);
+
+  std::cout << std::endl;
+}
+
+// calls f on the list and prints the exception it throws
+template <typename T, unsigned Size, typename F>
+void print_empty_throw(BList<T, Size> &list, const char *label, F f)
+{
+  try
+  {
+    f(list);
+    std::cout << label << ": No exception!" << std::endl;
+  }
+  catch (const BListException &e)
+  {
+    std::cout << label << ": caught BListException, code " << e.code() << ": " << e.what()
+              << std::endl;
+  }
+}
+
+// both ends: front, back, pop_front and pop_back, also in deque mode
+void testM()
+{
+  std::cout << "===== front, back, pop_front and pop_back =====\n";
+  const unsigned asize = 4;
+  typedef BList<int, asize> List;
+
+  List bl;
+  print_empty_throw(bl, "front    ", [](List &l) { l.front(); });
+  print_empty_throw(bl, "back     ", [](List &l) { l.back(); });
+  print_empty_throw(bl, "pop_front", [](List &l) { l.pop_front(); });
+  print_empty_throw(bl, "pop_back ", [](List &l) { l.pop_back(); });
+
+  for (int i = 1; i <= 10; i++)
+    bl.push_back(i);
+  bl.front() = 100;
+  bl.back() = 200;
+  const List &cbl = bl;
+  std::cout << "front " << cbl.front() << ", back " << cbl.back() << std::endl;
+  DumpList(bl, false);
+
+  // items shift down in the head, the tail just loses its last item
+  for (int i = 0; i < 3; i++)
+  {
+    bl.pop_front();
+    bl.pop_back();
+  }
+  std::cout << "3 x pop_front and pop_back: front " << bl.front() << ", back " << bl.back()
+            << std::endl;
+  DumpList(bl, false);
+  DumpStats(bl);
+
+  while (bl.size() > 1)
+    bl.pop_back();
+  std::cout << "one item, front " << bl.front() << ", back " << bl.back() << std::endl;
+  bl.pop_front();
+  print_empty_throw(bl, "pop_front on the emptied list", [](List &l) { l.pop_front(); });
+  DumpStats(bl);
+
+  // in deque mode pop_front only widens the gap in front of the head's items
+  List dq;
+  dq.set_deque_mode(true);
+  for (int i = 1; i <= 10; i++)
+    dq.push_back(i);
+  for (int i = 0; i < 4; i++)
+  {
+    dq.pop_front();
+    std::cout << "deque pop_front: front " << dq.front() << ", back " << dq.back()
+              << ", head offset " << dq.head_offset() << ", head count " << dq.GetHead()->count
+              << std::endl;
+  }
+  DumpList(dq, false);
+
+  // a full head gets a new head in front, filled from its last slot
+  dq.push_front(-1);
+  dq.push_front(-2);
+  std::cout << "push_front 2: front " << dq.front() << ", head offset " << dq.head_offset()
+            << std::endl;
+  DumpList(dq, false);
+
+  // pop_back down to the head, which keeps its gap
+  while (dq.size() > 2)
+    dq.pop_back();
+  std::cout << "pop_back to 2 items: front " << dq.front() << ", back " << dq.back()
+            << ", head offset " << dq.head_offset() << std::endl;
+  DumpList(dq, false);
+
+  // with rebalancing on, pop_front shifts the head as usual
+  List rb;
+  rb.set_deque_mode(true);
+  rb.set_rebalance(true);
+  for (int i = 1; i <= 10; i++)
+    rb.push_back(i);
+  rb.pop_front();
+  rb.pop_front();
+  std::cout << "deque with rebalancing: front " << rb.front() << ", head offset "
+            << rb.head_offset() << std::endl;
+  DumpList(rb, false);
+
+  dq.pop_front();
+  dq.pop_front();
+  print_empty_throw(dq, "deque front", [](List &l) { l.front(); });
+  print_empty_throw(dq, "deque back ", [](List &l) { l.back(); });
+  DumpStats(dq);
+
+  std::cout << std::endl;
+}
+
+// sort: small lists, deque mode, strings, and a list large enough for the parallel path
+void testN()
+{
+  std::cout << "===== sort =====\n";
+  const unsigned asize = 4;
+
+  BList<int, asize> bl;
+  bl.sort();
+  std::cout << "sort of an empty list, size " << bl.size() << std::endl;
+  bl.push_back(3);
+  bl.sort();
+  std::cout << "sort of one item:" << std::endl;
+  DumpList(bl, false);
+
+  for (int i = 0; i < 13; i++)
+    bl.push_back(i * 5 % 13);
+  bl.push_front(7);
+  bl.sort();
+  std::cout << "sort 15, equal items included:" << std::endl;
+  DumpList(bl, false);
+  DumpStats(bl);
+  bl.insert(6);
+  std::cout << "insert 6 after sorting:" << std::endl;
+  DumpList(bl, false);
+
+  // the head's gap in deque mode goes away
+  BList<int, asize> dq;
+  dq.set_deque_mode(true);
+  for (int i = 0; i < 10; i++)
+    dq.push_front(i * 3 % 10);
+  dq.pop_front();
+  std::cout << "deque mode, head offset " << dq.head_offset() << ":" << std::endl;
+  DumpList(dq, false);
+  dq.sort();
+  std::cout << "sorted, head offset " << dq.head_offset() << ":" << std::endl;
+  DumpList(dq, false);
+
+  BList<std::string, asize> words;
+  const char *text[] = {"pear", "fig", "apple", "kiwi", "date", "lime", "plum", "apple"};
+  for (const char *word : text)
+    words.push_back(word);
+  words.sort();
+  std::cout << "strings:" << std::endl;
+  DumpList(words, false);
+
+  // large enough to use several threads where there are several cores
+  const int count = (1 << 16) + 1000;
+  BList<int, 64> big;
+  std::vector<int> expected;
+  for (int i = 0; i < count; i++)
+  {
+    int value = static_cast<int>((static_cast<long long>(i) * 40503) % 50000);
+    big.push_back(value);
+    expected.push_back(value);
+  }
+  big.sort();
+  std::sort(expected.begin(), expected.end());
+
+  std::vector<int> items(big.cbegin(), big.cend());
+  std::cout << "sort " << count << ": size " << big.size() << ", sorted "
+            << (std::is_sorted(items.begin(), items.end()) ? "yes" : "no") << ", same as std::sort "
+            << (items == expected ? "yes" : "no") << std::endl;
+  std::cout << "first:";
+  for (int i = 0; i < 5; i++)
+    std::cout << " " << big[i];
+  std::cout << ", last:";
+  for (int i = count - 5; i < count; i++)
+    std::cout << " " << big[i];
+  std::cout << std::endl;
+
+  BListStats stats = big.GetStats();
+  std::cout << "Nodes: " << stats.NodeCount << ", all but the tail full: "
+            << (stats.NodeCount == (count + 63) / 64 ? "yes" : "no") << std::endl;
+
+  std::cout << std::endl;
+}
+
 int main(int argc, char **argv)
 {
    int test ;
@@ -1763,6 +2574,36 @@ int main(int argc, char **argv)
       testC();
       testD();
       break;
+    case 14:
+      testE();
+      break;
+    case 15:
+      testF();
+      break;
+    case 16:
+      testG();
+      break;
+    case 17:
+      testH();
+      break;
+    case 18:
+      testI();
+      break;
+    case 19:
+      testJ();
+      break;
+    case 20:
+      testK();
+      break;
+    case 21:
+      testL();
+      break;
+    case 22:
+      testM();
+      break;
+    case 23:
+      testN();
+      break;
   }
   return 0;
 }
@@ -37,7 +37,20 @@ void AVLTree<T>::insert(const T &value)
 template <typename T>
 bool AVLTree<T>::ImplementedBalanceFactor(void)
 {
-  return false;
+  return true;
+}
+/******************************************************************************/
+/*!
+\brief
+  An AVLTree holds each value once: insert ignores a value already in the
+  tree, so build_from_sorted keeps one copy of each value too.
+\return true.
+*/
+/******************************************************************************/
+template <typename T>
+bool AVLTree<T>::unique_values() const
+{
+  return true;
 }
 /******************************************************************************/
 /*!
@@ -59,19 +72,23 @@ void AVLTree<T>::remove(const T &value)
   This is the constructor for a AVLTree.
 \param oa, the object allocator(OA) to use.
 \param ShareOA, this boolean decides whether this AVLTree will share it's OA.
+\param ExpectedSize, roughly how many items the tree will hold (0 if unknown),
+  used to size the pages of its own OA.
 */
 /******************************************************************************/
 template <typename T>
-AVLTree<T>::AVLTree(ObjectAllocator *OA, bool ShareOA)
-    : BSTree<T>{OA, ShareOA}
+AVLTree<T>::AVLTree(ObjectAllocator *OA, bool ShareOA, unsigned ExpectedSize)
+    : BSTree<T>{OA, ShareOA, ExpectedSize}
 {
 }
 
 /******************************************************************************/
 /*!
 \brief
-  This function recursively inserts a value into the AVLTree.
-\param tree, current node.
+  This function inserts a value into the AVLTree. It walks down from the
+  root, recording the links it follows, adds the node, then rebalances
+  along the recorded path. A value already in the tree is left alone.
+\param tree, the root link.
 \param value, the data to insert.
 \param visited, visited nodes.
 */
@@ -79,56 +96,41 @@ AVLTree<T>::AVLTree(ObjectAllocator *OA, bool ShareOA)
 template <typename T>
 void AVLTree<T>::AVLInsert(BinTree &tree, const T &value, Stack &visited)
 {
-  if (tree == nullptr)
-  {
-    tree = BSTree<T>::make_node(value);
-    ++this->size_;
-    AVLBalance(visited);
-  }
-  else
-  {
-    visited.push(&tree);
-    ++tree->count;
-    if (value < tree->data)
-      InsertLeft(tree, value, visited);
-    else if (value > tree->data)
-      InsertRight(tree, value, visited);
-  }
-}
+    BinTree *link = &tree;
+    while (*link != nullptr)
+    {
+        if (value < (*link)->data)
+        {
+            visited.push(link);
+            link = &(*link)->left;
+        }
+        else if (value > (*link)->data)
+        {
+            visited.push(link);
+            link = &(*link)->right;
+        }
+        else
+            return;
+    }
 
-/**
- * Inserts a new node with the given value to the left subtree of the specified tree.
- * This function uses the AVLInsert function to maintain the AVL tree property.
- *
- * @param tree The tree to insert the node into.
- * @param value The value to be inserted.
- * @param visited A stack to keep track of visited nodes during the insertion process.
- */
-template <typename T>
-void AVLTree<T>::InsertLeft(BinTree &tree, const T &value, Stack &visited)
-{
-  AVLInsert(tree->left, value, visited);
-}
+    // Allocate first, so a failed allocation leaves the counts alone
+    *link = BSTree<T>::make_node(value);
+    ++this->sizeOfTree;
+    for (int i = 0; i < visited.size; ++i)
+        ++(*visited.links[i])->count;
 
-/**
- * Inserts a new node with the specified value as the right child of the given tree.
- * This function uses the AVLInsert function to maintain the AVL tree property.
- *
- * @param tree The tree to insert the new node into.
- * @param value The value to be inserted.
- * @param visited A stack to keep track of visited nodes during the insertion process.
- */
-template <typename T>
-void AVLTree<T>::InsertRight(BinTree &tree, const T &value, Stack &visited)
-{
-  AVLInsert(tree->right, value, visited);
+    AVLInsertBalance(visited, link);
 }
 
 /******************************************************************************/
 /*!
 \brief
-  This function recursively removes a value from the AVLTree.
-\param tree, current node.
+  This function removes a value from the AVLTree. It walks down from the
+  root, recording the links it follows. A node with two children takes
+  its predecessor's data, and the predecessor is unlinked instead, so the
+  node removed always has at most one child. It then rebalances along the
+  recorded path. A value not in the tree is left alone.
+\param tree, the root link.
 \param value, the data to remove.
 \param visited, visited nodes.
 */
@@ -136,146 +138,176 @@ void AVLTree<T>::InsertRight(BinTree &tree, const T &value, Stack &visited)
 template <typename T>
 void AVLTree<T>::AVLRemove(BinTree &tree, const T &value, Stack &visited)
 {
-    if (tree == nullptr)
-        return;
-    else if (value < tree->data)
+    BinTree *link = &tree;
+    while (*link != nullptr)
     {
-        visited.push(&tree);
-        --tree->count;
-        LeftRemove(tree, value, visited);
-    }
-    else if (value > tree->data)
-    {
-        visited.push(&tree);
-        --tree->count;
-        RightRemove(tree, value, visited);
-    }
-    else
-    {
-        --tree->count;
-        if (tree->left == nullptr)
+        if (value < (*link)->data)
         {
-            BinTree temp = tree;
-            tree = tree->right;
-            BSTree<T>::free_node(temp);
-            --this->size_;
+            visited.push(link);
+            link = &(*link)->left;
         }
-        else if (tree->right == nullptr)
+        else if (value > (*link)->data)
         {
-            BinTree temp = tree;
-            tree = tree->left;
-            BSTree<T>::free_node(temp);
-            --this->size_;
+            visited.push(link);
+            link = &(*link)->right;
         }
         else
+            break;
+    }
+
+    if (*link == nullptr)
+        return;
+
+    if ((*link)->left && (*link)->right)
+    {
+        // Replace the data with the predecessor's and remove that instead
+        BinTree node = *link;
+        visited.push(link);
+        link = &node->left;
+        while ((*link)->right)
         {
-            BinTree pred = nullptr;
-            BSTree<T>::find_predecessor(tree, pred);
-            tree->data = pred->data;
-            AVLRemove(tree->left, tree->data, visited);
+            visited.push(link);
+            link = &(*link)->right;
         }
-        AVLBalance(visited);
+        node->data = (*link)->data;
     }
-}
 
-/**
- * Removes the specified value from the left subtree of the given AVL tree.
- * 
- * @param tree The AVL tree.
- * @param value The value to be removed.
- * @param visited The stack to keep track of visited nodes.
- */
-template <typename T>
-void AVLTree<T>::LeftRemove(BinTree &tree, const T &value, Stack &visited)
-{
-    AVLRemove(tree->left, value, visited);
+    for (int i = 0; i < visited.size; ++i)
+        --(*visited.links[i])->count;
+
+    BinTree temp = *link;
+    *link = temp->left ? temp->left : temp->right;
+    BSTree<T>::free_node(temp);
+    --this->sizeOfTree;
+    AVLRemoveBalance(visited, link);
 }
 
-/**
- * Removes the specified value from the right subtree of the given AVL tree.
- * This function is called recursively to remove the value from the right subtree.
- *
- * @param tree The AVL tree.
- * @param value The value to be removed.
- * @param visited A stack to keep track of visited nodes during the removal process.
- */
+/******************************************************************************/
+/*!
+\brief
+  This function updates the balance factors along the path of an insertion,
+  from the new node up, and rotates at the first node that becomes
+  unbalanced. It stops as soon as a subtree's height is unchanged, so the
+  work is O(1) per level with at most one rotation.
+\param visited, visited nodes aka path.
+\param child, the link (on the path) to the subtree that grew.
+*/
+/******************************************************************************/
 template <typename T>
-void AVLTree<T>::RightRemove(BinTree &tree, const T &value, Stack &visited)
+void AVLTree<T>::AVLInsertBalance(Stack &visited, BinTree *child)
 {
-    AVLRemove(tree->right, value, visited);
-}
+    while (!visited.empty())
+    {
+        BinTree *node = visited.top();
+        visited.pop();
 
+        if (child == &(*node)->left)
+            --(*node)->balance_factor;
+        else
+            ++(*node)->balance_factor;
+
+        // Both sides are now the same height, so this subtree did not grow
+        if ((*node)->balance_factor == 0)
+            return;
+
+        if ((*node)->balance_factor == 2)
+        {
+            RightBalance(node);
+            return;
+        }
+        else if ((*node)->balance_factor == -2)
+        {
+            LeftBalance(node);
+            return;
+        }
+
+        child = node;
+    }
+}
 
 /******************************************************************************/
 /*!
 \brief
-  This function balances the AVLTree along a given path.
+  This function updates the balance factors along the path of a removal,
+  from the removed node up, rotating wherever a node becomes unbalanced. It
+  stops as soon as a subtree's height is unchanged.
 \param visited, visited nodes aka path.
+\param child, the link (on the path) to the subtree that shrank.
 */
 /******************************************************************************/
 template <typename T>
-void AVLTree<T>::AVLBalance(Stack &visited)
+void AVLTree<T>::AVLRemoveBalance(Stack &visited, BinTree *child)
 {
     while (!visited.empty())
     {
         BinTree *node = visited.top();
         visited.pop();
-        int height_left = BSTree<T>::tree_height((*node)->left);
-        int height_right = BSTree<T>::tree_height((*node)->right);
 
-        if (std::abs(height_left - height_right) < 2)
-            continue;
+        if (child == &(*node)->left)
+            ++(*node)->balance_factor;
+        else
+            --(*node)->balance_factor;
+
+        // One side is still as tall as before, so this subtree did not shrink
+        if ((*node)->balance_factor == 1 || (*node)->balance_factor == -1)
+            return;
 
-        if (height_right > height_left)
+        if ((*node)->balance_factor == 2)
         {
-            if ((*node)->right)
-            {
-                RightBalance(node);
-                AVLRecount(*node);
-            }
+            bool shorter = RightBalance(node);
+            if (!shorter)
+                return;
         }
-        else if (height_right < height_left)
+        else if ((*node)->balance_factor == -2)
         {
-            if ((*node)->left)
-            {
-                LeftBalance(node);
-                AVLRecount(*node);
-            }
+            bool shorter = LeftBalance(node);
+            if (!shorter)
+                return;
         }
+
+        child = node;
     }
 }
 
 /**
  * Performs right balancing on the AVL tree.
- * This function is called when the right subtree of a node becomes unbalanced.
- * It checks if a right rotation or a left rotation is required to balance the tree.
- * If the left subtree of the right child of the given node is taller than the right subtree,
- * a right rotation is performed on the right child.
- * Otherwise, a left rotation is performed on the given node.
+ * This function is called when the right subtree of a node is two levels
+ * taller than the left (balance factor 2).
+ * If the left subtree of the right child is taller than its right subtree,
+ * a right rotation is performed on the right child first.
+ * Then a left rotation is performed on the given node.
  *
  * @param node A pointer to the node that needs right balancing.
+ * @return true if the subtree is one level shorter after the rotation(s),
+ *         false if its height is unchanged (only possible after a removal).
  */
 template <typename T>
-void AVLTree<T>::RightBalance(BinTree *node)
+bool AVLTree<T>::RightBalance(BinTree *node)
 {
-    if (BSTree<T>::tree_height((*node)->right->left) > BSTree<T>::tree_height((*node)->right->right))
+    bool shorter = (*node)->right->balance_factor != 0;
+    if ((*node)->right->balance_factor < 0)
         RightRotate((*node)->right);
     LeftRotate((*node));
+    return shorter;
 }
 
 /**
  * Performs a left balance operation on the AVL tree.
- * This operation is used to maintain the balance of the tree after a node insertion or deletion.
- * It checks if the left subtree of the given node is unbalanced and performs necessary rotations to restore balance.
+ * This function is called when the left subtree of a node is two levels
+ * taller than the right (balance factor -2), and mirrors RightBalance.
  * 
  * @param node A pointer to the node that needs left balancing.
+ * @return true if the subtree is one level shorter after the rotation(s),
+ *         false if its height is unchanged (only possible after a removal).
  */
 template <typename T>
-void AVLTree<T>::LeftBalance(BinTree *node)
+bool AVLTree<T>::LeftBalance(BinTree *node)
 {
-    if (BSTree<T>::tree_height((*node)->left->left) < BSTree<T>::tree_height((*node)->left->right))
+    bool shorter = (*node)->left->balance_factor != 0;
+    if ((*node)->left->balance_factor > 0)
         LeftRotate((*node)->left);
     RightRotate((*node));
+    return shorter;
 }
 
 
@@ -301,6 +333,14 @@ void AVLTree<T>::LeftRotate(BinTree &tree)
     right_child->left = pivot;
     pivot->right = left_subtree_of_right_child;
     tree = right_child;
+
+    // Only the two nodes that moved change; the new root keeps the old subtree's count
+    right_child->count = pivot->count;
+    pivot->count = 1 + SubtreeCount(pivot->left) + SubtreeCount(pivot->right);
+
+    // Update the balance factors (right height - left height) of the two nodes that moved
+    pivot->balance_factor -= 1 + std::max(right_child->balance_factor, 0);
+    right_child->balance_factor -= 1 - std::min(pivot->balance_factor, 0);
 }
 
 
@@ -326,50 +366,28 @@ void AVLTree<T>::RightRotate(BinTree &tree)
     left_child->right = pivot;
     pivot->left = right_subtree_of_left_child;
     tree = left_child;
-}
 
+    // Only the two nodes that moved change; the new root keeps the old subtree's count
+    left_child->count = pivot->count;
+    pivot->count = 1 + SubtreeCount(pivot->left) + SubtreeCount(pivot->right);
 
-/******************************************************************************/
-/*!
-\brief
-  This function recursively counts the number of nodes in the subtree.
-\param tree, the parent node.
-*/
-/******************************************************************************/
-template <typename T>
-unsigned int AVLTree<T>::CountTree(BinTree &tree)
-{
-    if (tree == nullptr)
-        return 0;
-
-    // Count the number of nodes in the subtree rooted at the current node
-    unsigned int left_count = CountTree(tree->left);
-    unsigned int right_count = CountTree(tree->right);
-
-    // Return the total count including the current node
-    return 1 + left_count + right_count;
+    // Update the balance factors (right height - left height) of the two nodes that moved
+    pivot->balance_factor += 1 - std::min(left_child->balance_factor, 0);
+    left_child->balance_factor += 1 + std::max(pivot->balance_factor, 0);
 }
 
 
 /******************************************************************************/
 /*!
 \brief
-  This function recursively counts the number of nodes in the subtree for every
-  subtree.
-\param tree, the parent node.
+  This function returns the number of nodes in a subtree, as stored in its
+  root.
+\param tree, the root of the subtree (may be null).
+\return the node count, 0 for an empty subtree.
 */
 /******************************************************************************/
 template <typename T>
-void AVLTree<T>::AVLRecount(BinTree &tree)
+unsigned int AVLTree<T>::SubtreeCount(BinTree tree) const
 {
-    if (tree == nullptr)
-        return;
-
-    // Count the number of nodes in the subtree
-    tree->count = 1 + CountTree(tree->left) + CountTree(tree->right);
-
-    // Recursively update counts for left and right subtrees
-    AVLRecount(tree->left);
-    AVLRecount(tree->right);
+    return tree ? tree->count : 0;
 }
-
@@ -14,7 +14,7 @@
 #ifndef AVLTREE_H
 #define AVLTREE_H
 //---------------------------------------------------------------------------
-#include <stack>
+#include <algorithm> // std::max, std::min
 #include "BSTree.h"
 
 /*!
@@ -24,7 +24,7 @@ template <typename T>
 class AVLTree : public BSTree<T>
 {
   public:
-    AVLTree(ObjectAllocator *oa = 0, bool ShareOA = false);
+    AVLTree(ObjectAllocator *oa = 0, bool ShareOA = false, unsigned ExpectedSize = 0);
     virtual ~AVLTree() = default; // DO NOT IMPLEMENT
     virtual void insert(const T& value) override;
     virtual void remove(const T& value) override;
@@ -32,31 +32,38 @@ class AVLTree : public BSTree<T>
     // Returns true if efficiency implemented
     static bool ImplementedBalanceFactor(void);
 
+  protected:
+    virtual bool unique_values() const override; // insert ignores values already present
+
   private:
     using BinTree = typename BSTree<T>::BinTree;
+
+    //! Longest root-to-leaf path: an AVL tree of 2^32 nodes is at most
+    //! 1.44 * log2(n) = 44 levels high, so 48 links always fit.
+    static const int MaxPathLength = 48;
+
+    //! The links followed from the root, kept on the call stack
+    struct Stack
+    {
+      BinTree *links[MaxPathLength]; //!< links[0] is the root link
+      int size = 0;                  //!< links in use
+
+      bool empty() const { return size == 0; }
+      BinTree *top() const { return links[size - 1]; }
+      void push(BinTree *link) { links[size++] = link; }
+      void pop() { --size; }
+    };
+
     void LeftRotate(BinTree& tree);
-    using Stack = std::stack<BinTree *>;
-    void AVLBalance(Stack& visited);
-    // private stuff
-    
-    unsigned int CountTree(BinTree& tree);
-    void AVLRecount(BinTree& tree);
-    void InsertRight(BinTree &tree, const T &value, Stack &visited);
     void RightRotate(BinTree& tree);
+    unsigned int SubtreeCount(BinTree tree) const;
 
-    // Helper functions
-    void InsertLeft(BinTree &tree, const T &value, Stack &visited);
-
-    // Helper functions for removal
-    void LeftRemove(BinTree &tree, const T &value, Stack &visited);
-    void RightRemove(BinTree &tree, const T &value, Stack &visited);
-    
-    void RightBalance(BinTree *node);
-    void LeftBalance(BinTree *node);
-    void AVLRemove(BinTree& tree, const T& value, Stack& visited);
     void AVLInsert(BinTree& tree, const T& value, Stack& visited);
-    
-    
+    void AVLRemove(BinTree& tree, const T& value, Stack& visited);
+    void AVLInsertBalance(Stack& visited, BinTree *child);
+    void AVLRemoveBalance(Stack& visited, BinTree *child);
+    bool RightBalance(BinTree *node);
+    bool LeftBalance(BinTree *node);
 };
 
 #include "AVLTree.cpp"
@@ -11,18 +11,29 @@
  *********************************************************************/
 /******************************************************************************/
 #include "BSTree.h"
+#include <algorithm> // std::max, std::min, std::sort
+#include <future>    // std::async
+#include <utility>   // std::pair
+#include <vector>    // std::vector
 
 /**
  * @brief Constructs a new BSTree object.
  *
+ * Unless an allocator is shared, the tree makes its own pooled allocator, so
+ * nodes come from pages of contiguous blocks instead of one new each.
+ *
  * @tparam T The type of elements stored in the BSTree.
  * @param oa Pointer to the ObjectAllocator used for memory management.
  * @param ShareOA Flag indicating whether to share the ObjectAllocator or create a new one.
+ * @param ExpectedSize Roughly how many items the tree will hold (0 if unknown), used to size
+ *        the pages of its own allocator.
  */
 template <typename T>
-BSTree<T>::BSTree(ObjectAllocator *oa, bool ShareOA)
-    : rootNode(nullptr), sizeOfTree(0), heightOfTree(-1), OA(ShareOA ? oa : new ObjectAllocator(sizeof(BinTreeNode), OAConfig(true))),
-      freeOA(!oa && !ShareOA), shareOA(ShareOA) {}
+BSTree<T>::BSTree(ObjectAllocator *oa, bool ShareOA, unsigned ExpectedSize)
+    : rootNode(nullptr), sizeOfTree(0), heightOfTree(-1), OA(nullptr), freeOA(false), shareOA(false)
+{
+  InitializeAllocator(oa, ShareOA, ExpectedSize);
+}
 
 template <typename T>
 /**
@@ -33,33 +44,62 @@ template <typename T>
 BSTree<T>::BSTree(const BSTree &rhs)
     : rootNode(nullptr), sizeOfTree(0), heightOfTree(-1), OA(nullptr), freeOA(false), shareOA(false)
 {
-  InitializeAllocator(rhs.shareOA ? rhs.OA : nullptr, rhs.shareOA);
+  InitializeAllocator(rhs.shareOA ? rhs.OA : nullptr, rhs.shareOA, rhs.sizeOfTree);
   CopyTree(rhs.rootNode, rootNode);
   sizeOfTree = rhs.sizeOfTree;
   heightOfTree = rhs.heightOfTree;
 }
 
+/**
+ * @brief Creates a pooled object allocator for the nodes of one tree.
+ *
+ * The page size follows the expected number of items, within limits, so a
+ * small tree does not hold a large page and a big one does not need
+ * thousands of small ones. There is no limit on the number of pages.
+ *
+ * @param expectedSize Roughly how many items the tree will hold, 0 if unknown.
+ * @return The new allocator, owned by the caller.
+ * @throws BSTException if the first page cannot be allocated.
+ */
+template <typename T>
+ObjectAllocator *BSTree<T>::CreateAllocator(unsigned expectedSize)
+{
+  unsigned nodesPerPage = DefaultNodesPerPage;
+  if (expectedSize)
+    nodesPerPage = expectedSize < MinNodesPerPage   ? MinNodesPerPage
+                   : expectedSize > MaxNodesPerPage ? MaxNodesPerPage
+                                                    : expectedSize;
+  try
+  {
+    return new ObjectAllocator(sizeof(BinTreeNode), OAConfig(false, nodesPerPage, 0));
+  }
+  catch (const OAException &except)
+  {
+    throw(BSTException(BSTException::E_NO_MEMORY, except.what()));
+  }
+}
+
 template <typename T>
 /**
  * @brief Initializes the object allocator for the binary search tree.
  *
  * @param oa Pointer to the object allocator.
  * @param shareOA Flag indicating whether to share the object allocator with other data structures.
+ * @param expectedSize Roughly how many items the tree will hold, for its own allocator.
  */
-void BSTree<T>::InitializeAllocator(ObjectAllocator *oa, bool shareOA)
+void BSTree<T>::InitializeAllocator(ObjectAllocator *oa, bool shareOA, unsigned expectedSize)
 {
   if (shareOA)
   {
     OA = oa;
     freeOA = false;
-    shareOA = true;
+    this->shareOA = true;
   }
   else
   {
-    OAConfig config(true);
-    OA = new ObjectAllocator(sizeof(BinTreeNode), config);
+    OA = CreateAllocator(expectedSize);
     freeOA = true;
-    shareOA = false;
+    this->shareOA = false;
   }
 }
 
@@ -84,6 +124,7 @@ BSTree<T>::~BSTree()
  * @brief Assignment operator overload for BSTree.
  * 
  * This function assigns the contents of the right-hand side BSTree object to the left-hand side BSTree object.
+ * The old nodes are freed first, and an allocator this tree owns is kept for the new ones.
  * 
  * @tparam T The type of elements stored in the BSTree.
  * @param rhs The right-hand side BSTree object to be assigned.
@@ -95,6 +136,7 @@ BSTree<T> &BSTree<T>::operator=(const BSTree &rhs)
   if (this == &rhs)
     return *this;
 
+  clear();
   HandleObjectAllocator(rhs);
   CopyTree(rhs.rootNode, rootNode);
   sizeOfTree = rhs.sizeOfTree;
@@ -108,6 +150,8 @@ template <typename T>
  * @brief Handles the object allocator for the BSTree class.
  * 
  * This function is responsible for handling the object allocator when copying the contents of another BSTree object.
+ * A tree that shares its allocator makes this one share it too; otherwise this tree uses its own allocator,
+ * creating one if it was sharing before. The tree must be empty.
  * 
  * @param rhs The BSTree object to be copied.
  */
@@ -116,18 +160,15 @@ void BSTree<T>::HandleObjectAllocator(const BSTree &rhs)
   if (rhs.shareOA)
   {
     if (freeOA)
-    {
-      clear();
       delete OA;
-    }
 
     OA = rhs.OA;
     freeOA = false;
     shareOA = true;
   }
-  else
+  else if (!freeOA)
   {
-    InitializeAllocator(rhs.OA, false);
+    InitializeAllocator(nullptr, false, rhs.sizeOfTree);
   }
 }
 
@@ -204,6 +245,90 @@ void BSTree<T>::clear()
   }
 }
 
+/**
+ * @brief Preallocates nodes so the tree can grow to the given size without
+ * the allocator adding pages.
+ * 
+ * The extra nodes are allocated and then freed in reverse order, which leaves
+ * them at the front of the allocator's free list in address order, so nodes
+ * inserted next are laid out next to each other.
+ * 
+ * @param n The number of items the tree should be able to hold.
+ * @throws BSTException if the memory cannot be allocated. Nothing is reserved then.
+ */
+template <typename T>
+void BSTree<T>::reserve(unsigned n)
+{
+  if (n <= sizeOfTree)
+    return;
+
+  const size_t extra = n - sizeOfTree;
+  std::vector<void *> blocks;
+  blocks.reserve(extra);
+  try
+  {
+    while (blocks.size() < extra)
+      blocks.push_back(OA->Allocate());
+  }
+  catch (const OAException &except)
+  {
+    for (void *block : blocks)
+      OA->Free(block);
+    throw(BSTException(BSTException::E_NO_MEMORY, except.what()));
+  }
+
+  for (auto it = blocks.rbegin(); it != blocks.rend(); ++it)
+    OA->Free(*it);
+}
+
+/**
+ * @brief Replaces the contents of the tree with the values in a range,
+ * building a perfectly balanced tree in O(n).
+ * 
+ * The range is checked in one pass; if it is not in ascending order it is
+ * copied and sorted first (O(n log n)). Repeated values are kept, as insert
+ * keeps them, unless unique_values() says the tree holds each value once
+ * (AVLTree), in which case one copy of each is kept. The nodes are reserved
+ * up front, then made in order, with each node's count
+ * and balance factor set directly, so no rotations or recounts are needed.
+ * The result is also a valid AVL tree (every balance factor is 0 or 1).
+ * 
+ * @tparam Iterator A forward iterator over values of type T. The range is
+ *         read more than once, so input iterators are rejected.
+ * @param first The first value.
+ * @param last One past the last value.
+ * @throws BSTException if the memory cannot be allocated. The tree is then empty.
+ */
+template <typename T>
+template <typename Iterator>
+void BSTree<T>::build_from_sorted(Iterator first, Iterator last)
+{
+  static_assert(std::is_base_of<std::forward_iterator_tag,
+                                typename std::iterator_traits<Iterator>::iterator_category>::value,
+                "build_from_sorted needs a forward iterator: the range is read twice");
+
+  const bool unique = unique_values();
+  size_t n = 0;
+  for (Iterator it = first, previous = first; it != last; previous = it, ++it)
+  {
+    if (it != first && *it < *previous)
+    {
+      std::vector<T> sorted(first, last);
+      std::sort(sorted.begin(), sorted.end());
+      build_from_sorted(sorted.begin(), sorted.end());
+      return;
+    }
+    if (!unique || it == first || *previous < *it)
+      ++n;
+  }
+
+  clear();
+  reserve(static_cast<unsigned>(n));
+  rootNode = BuildBalanced(first, last, n, unique);
+  sizeOfTree = static_cast<unsigned>(n);
+  heightOfTree = BalancedHeight(n);
+}
+
 /**
  * @brief Finds a value in the binary search tree.
  * 
@@ -221,6 +346,44 @@ bool BSTree<T>::find(const T &value, unsigned &compares) const
   return FindNode(rootNode, value, compares);
 }
 
+/**
+ * @brief Looks up many values at once.
+ * 
+ * A single find spends most of its time waiting for the next node to arrive
+ * from memory. Here several lookups advance in turn, one level each, and
+ * each prefetches its next node, so their cache misses overlap. With more
+ * than one thread the keys are split into contiguous parts, one per thread.
+ * The tree must not change during the call.
+ * 
+ * @param keys The values to search for.
+ * @param n The number of values.
+ * @param out Set to true for each value found, false otherwise.
+ * @param threads The number of threads to use, including the caller's.
+ */
+template <typename T>
+void BSTree<T>::find_batch(const T *keys, size_t n, bool *out, unsigned threads) const
+{
+  if (threads > n / MinKeysPerThread)
+    threads = static_cast<unsigned>(n / MinKeysPerThread);
+  if (threads <= 1)
+  {
+    FindInterleaved(keys, n, out);
+    return;
+  }
+
+  const size_t part = (n + threads - 1) / threads;
+  std::vector<std::future<void> > parts;
+  for (size_t first = part; first < n; first += part)
+  {
+    const size_t count = std::min(part, n - first);
+    parts.push_back(std::async(std::launch::async, [=] { FindInterleaved(keys + first, count, out + first); }));
+  }
+
+  FindInterleaved(keys, part, out);
+  for (auto &future : parts)
+    future.get();
+}
+
 /**
  * @brief Checks if the binary search tree is empty.
  * 
@@ -269,6 +432,121 @@ typename BSTree<T>::BinTree BSTree<T>::root() const
   return rootNode;
 }
 
+/**
+ * @brief Makes a read-only search index of the values in the tree.
+ * 
+ * For a tree that is built once and then only searched. The values are
+ * copied out in order into an
+ * EytzingerIndex, whose find gives the same answer as the tree's and counts
+ * compares the same way, over the complete tree it stores. Later changes to
+ * the tree do not affect the index.
+ * 
+ * @return The index.
+ */
+template <typename T>
+EytzingerIndex<T> BSTree<T>::freeze() const
+{
+  std::vector<T> sorted;
+  sorted.reserve(sizeOfTree);
+  for (const_iterator it = begin(); it != end(); ++it)
+    sorted.push_back(*it);
+
+  return EytzingerIndex<T>(sorted);
+}
+
+/**
+ * @brief Returns an iterator to the smallest value.
+ * 
+ * @return The iterator, equal to end() if the tree is empty.
+ */
+template <typename T>
+typename BSTree<T>::const_iterator BSTree<T>::begin() const
+{
+  const_iterator it;
+  it.PushLeftmost(rootNode);
+  return it;
+}
+
+/**
+ * @brief Returns the iterator past the largest value.
+ * 
+ * @return The end iterator.
+ */
+template <typename T>
+typename BSTree<T>::const_iterator BSTree<T>::end() const
+{
+  return const_iterator();
+}
+
+/**
+ * @brief Finds the first value, in sorted order, that is not less than a
+ * value, in O(height).
+ * 
+ * The search keeps the nodes where it goes left, which are exactly the
+ * ancestors an in-order walk from the result still has to visit. A range
+ * scan of k values from here is O(height + k).
+ * 
+ * @param value The value to search for.
+ * @return The iterator, end() if every value is less.
+ */
+template <typename T>
+typename BSTree<T>::const_iterator BSTree<T>::lower_bound(const T &value) const
+{
+  const_iterator it;
+  for (BinTree tree = rootNode; tree != nullptr;)
+  {
+    if (tree->data < value)
+      tree = tree->right;
+    else
+    {
+      it.path.push_back(tree);
+      tree = tree->left;
+    }
+  }
+  return it;
+}
+
+/**
+ * @brief Finds the first value, in sorted order, that is greater than a
+ * value, in O(height).
+ * 
+ * @param value The value to search for.
+ * @return The iterator, end() if no value is greater.
+ */
+template <typename T>
+typename BSTree<T>::const_iterator BSTree<T>::upper_bound(const T &value) const
+{
+  const_iterator it;
+  for (BinTree tree = rootNode; tree != nullptr;)
+  {
+    if (value < tree->data)
+    {
+      it.path.push_back(tree);
+      tree = tree->left;
+    }
+    else
+      tree = tree->right;
+  }
+  return it;
+}
+
+/**
+ * @brief Counts the values in the half-open range [lo, hi) in O(height),
+ * from the subtree counts, without visiting them.
+ * 
+ * @param lo The smallest value counted.
+ * @param hi The first value not counted.
+ * @return The number of values v with lo <= v < hi, 0 if hi is not greater than lo.
+ */
+template <typename T>
+unsigned int BSTree<T>::count_range(const T &lo, const T &hi) const
+{
+  if (!(lo < hi))
+    return 0;
+
+  return CountLess(hi) - CountLess(lo);
+}
+
 /**
  * @brief Returns a reference to the root node of the binary search tree.
  * 
@@ -372,15 +650,37 @@ int BSTree<T>::tree_height(BinTree tree) const
 /**
  * Calculates the height of a binary search tree.
  * 
+ * The tree is walked depth first with an explicit stack of pending right
+ * subtrees instead of recursion, so a degenerate tree (e.g. one built from
+ * a sorted dictionary) does not overflow the call stack.
+ * 
  * @param tree The binary search tree.
  * @return The height of the binary search tree.
  */
 template <typename T>
 int BSTree<T>::CalculateTreeHeight(BinTree tree) const
 {
-  int height_left = tree_height(tree->left);
-  int height_right = tree_height(tree->right);
-  return std::max(height_left, height_right) + 1;
+  std::vector<std::pair<BinTree, int> > pending;
+  int height = -1;
+  int depth = 0;
+
+  while (tree != nullptr || !pending.empty())
+  {
+    if (tree == nullptr)
+    {
+      tree = pending.back().first;
+      depth = pending.back().second;
+      pending.pop_back();
+    }
+
+    height = std::max(height, depth);
+    if (tree->right)
+      pending.push_back(std::make_pair(tree->right, depth + 1));
+    tree = tree->left;
+    ++depth;
+  }
+
+  return height;
 }
 
 /**
@@ -397,6 +697,18 @@ void BSTree<T>::find_predecessor(BinTree tree, BinTree &predecessor) const
   predecessor = FindRightmostNode(tree->left);
 }
 
+/**
+ * @brief Tells whether insert keeps one copy of each value. A BSTree keeps
+ * every copy; build_from_sorted follows the same rule.
+ *
+ * @return false.
+ */
+template <typename T>
+bool BSTree<T>::unique_values() const
+{
+  return false;
+}
+
 /**
  * Finds the rightmost node in a binary search tree.
  * 
@@ -415,9 +727,10 @@ typename BSTree<T>::BinTree BSTree<T>::FindRightmostNode(BinTree node) const
 /**
  * @brief Copies the contents of a binary tree from the source to the destination.
  * 
- * This function recursively copies each node of the source binary tree to the destination binary tree.
+ * This function copies each node of the source binary tree to the destination binary tree.
  * It creates a new node in the destination tree for each node in the source tree and copies the data,
- * count, and balance factor from the source node to the destination node.
+ * count, and balance factor from the source node to the destination node. Left links are followed
+ * in a loop and right subtrees wait on an explicit stack, so deep trees do not recurse.
  * 
  * @tparam T The type of data stored in the binary tree.
  * @param source The root node of the source binary tree.
@@ -426,23 +739,34 @@ typename BSTree<T>::BinTree BSTree<T>::FindRightmostNode(BinTree node) const
 template <typename T>
 void BSTree<T>::CopyTree(const BinTree &source, BinTree &dest)
 {
-  if (source == nullptr)
-    dest = nullptr;
+  std::vector<std::pair<BinTree, BinTree *> > pending;
+  BinTree from = source;
+  BinTree *to = &dest;
+  *to = nullptr;
 
-  else
+  while (from != nullptr || !pending.empty())
   {
-    dest = make_node(source->data);
-    dest->count = source->count;
-    dest->balance_factor = source->balance_factor;
-    CopyTree(source->left, dest->left);
-    CopyTree(source->right, dest->right);
+    if (from == nullptr)
+    {
+      from = pending.back().first;
+      to = pending.back().second;
+      pending.pop_back();
+    }
+
+    *to = make_node(from->data);
+    (*to)->count = from->count;
+    (*to)->balance_factor = from->balance_factor;
+    if (from->right)
+      pending.push_back(std::make_pair(from->right, &(*to)->right));
+    from = from->left;
+    to = &(*to)->left;
   }
 }
 
 /**
  * @brief Frees the memory occupied by a binary tree.
  * 
- * This function recursively frees the memory occupied by a binary tree.
+ * This function frees the memory occupied by a binary tree.
  * It starts from the root node and frees each node and its children.
  * 
  * @param tree The binary tree to be freed.
@@ -454,7 +778,11 @@ void BSTree<T>::FreeTree(BinTree tree)
 }
 
 /**
- * @brief Recursively frees the memory allocated for a binary tree and its subtrees.
+ * @brief Frees the memory allocated for a binary tree and its subtrees.
+ * 
+ * Without recursion or extra memory: a node with a left child is rotated
+ * right until the root has none, then the root is freed and its right
+ * subtree is next. Each node is rotated at most once.
  * 
  * @param tree The root of the binary tree to be freed.
  * @tparam T The type of data stored in the binary tree.
@@ -462,51 +790,58 @@ void BSTree<T>::FreeTree(BinTree tree)
 template <typename T>
 void BSTree<T>::FreeSubtree(BinTree tree)
 {
-  if (tree == nullptr)
-    return;
-
-  FreeSubtree(tree->left);
-  FreeSubtree(tree->right);
-
-  free_node(tree);
+  while (tree != nullptr)
+  {
+    if (tree->left)
+    {
+      BinTree left = tree->left;
+      tree->left = left->right;
+      left->right = tree;
+      tree = left;
+    }
+    else
+    {
+      BinTree right = tree->right;
+      free_node(tree);
+      tree = right;
+    }
+  }
 }
 
 /**
  * @brief Inserts a new node with the given value into the binary search tree.
  * 
- * This function recursively traverses the binary search tree to find the appropriate
- * position to insert the new node. If the tree is empty, a new node is created and
- * assigned the given value. If the value is less than the current node's data, the
- * function is called recursively on the left subtree. Otherwise, the function is called
- * recursively on the right subtree.
+ * This function walks down the binary search tree to find the appropriate
+ * position to insert the new node, incrementing the count of each node it
+ * passes. Values less than a node's data go left, all others go right. If
+ * the allocation fails, the counts are put back before the exception leaves.
  * 
  * @tparam T The type of data stored in the binary search tree.
- * @param node A reference to the current node being considered.
+ * @param node A reference to the root of the (sub)tree.
  * @param value The value to be inserted into the binary search tree.
- * @param depth The current depth of the recursion.
+ * @param depth The depth of the root of the (sub)tree.
  * @throws BSTException if an error occurs during the insertion process.
  */
 template <typename T>
 void BSTree<T>::InsertNode(BinTree &node, const T &value, int depth)
 {
-  try
+  BinTree *link = &node;
+  while (*link != nullptr)
   {
-    if (node == nullptr)
-    {
-      HandleNewNodeCreation(node, value, depth);
-      return;
-    }
-
-    IncrementNodeCount(node);
+    IncrementNodeCount(*link);
+    link = value < (*link)->data ? &(*link)->left : &(*link)->right;
+    ++depth;
+  }
 
-    if (value < node->data)
-      InsertNode(node->left, value, depth + 1);
-    else
-      InsertNode(node->right, value, depth + 1);
+  try
+  {
+    HandleNewNodeCreation(*link, value, depth);
   }
-  catch (const BSTException &except)
+  catch (const BSTException &)
   {
-    throw except;
+    for (BinTree tree = node; tree != nullptr; tree = value < tree->data ? tree->left : tree->right)
+      DecrementNodeCount(tree);
+    throw;
   }
 }
 
@@ -524,9 +859,9 @@ void BSTree<T>::InsertNode(BinTree &node, const T &value, int depth)
 template <typename T>
 void BSTree<T>::HandleNewNodeCreation(BinTree &node, const T &value, int depth)
 {
+  node = make_node(value);
   if (depth > heightOfTree)
     ++heightOfTree;
-  node = make_node(value);
   ++sizeOfTree;
 }
 
@@ -545,8 +880,9 @@ void BSTree<T>::IncrementNodeCount(BinTree &node)
 /**
  * @brief Deletes a node with the specified value from the binary search tree.
  * 
- * This function recursively searches for the node with the specified value in the binary search tree.
- * If the node is found, it is deleted from the tree.
+ * This function searches for the node with the specified value in the binary search tree.
+ * If the node is found, the count of every node from the root down to it is decremented
+ * and it is deleted from the tree. If not, the tree is left unchanged.
  * 
  * @param node The root node of the binary search tree.
  * @param value The value to be deleted from the tree.
@@ -556,23 +892,17 @@ void BSTree<T>::IncrementNodeCount(BinTree &node)
 template <typename T>
 void BSTree<T>::DeleteNode(BinTree &node, const T &value)
 {
-  if (node == nullptr)
+  BinTree *link = &node;
+  while (*link != nullptr && (value < (*link)->data || value > (*link)->data))
+    link = value < (*link)->data ? &(*link)->left : &(*link)->right;
+
+  if (*link == nullptr)
     return;
-  else if (value < node->data)
-  {
-    DecrementNodeCount(node);
-    DeleteNode(node->left, value);
-  }
-  else if (value > node->data)
-  {
-    DecrementNodeCount(node);
-    DeleteNode(node->right, value);
-  }
-  else
-  {
-    DecrementNodeCount(node);
-    HandleNodeDeletion(node);
-  }
+
+  for (BinTree tree = node; tree != *link; tree = value < tree->data ? tree->left : tree->right)
+    DecrementNodeCount(tree);
+  DecrementNodeCount(*link);
+  HandleNodeDeletion(*link);
 }
 
 /**
@@ -651,9 +981,10 @@ void BSTree<T>::ReplaceNodeWithLeftChild(BinTree &node)
 /**
  * @brief Finds a node with the specified value in the binary search tree.
  * 
- * This function recursively searches for a node with the specified value in the binary search tree.
+ * This function walks down the binary search tree looking for a node with the specified value.
  * It returns true if the node is found, and false otherwise.
- * The number of comparisons made during the search is stored in the 'compares' parameter.
+ * The number of comparisons made during the search is stored in the 'compares' parameter:
+ * one for each node visited, plus one for the empty subtree where an unsuccessful search ends.
  * 
  * @param node The root node of the binary search tree.
  * @param value The value to search for.
@@ -663,58 +994,199 @@ void BSTree<T>::ReplaceNodeWithLeftChild(BinTree &node)
 template <typename T>
 bool BSTree<T>::FindNode(BinTree node, const T &value, unsigned &compares) const
 {
-  ++compares;
+  while (true)
+  {
+    ++compares;
 
-  if (node == nullptr)
-    return false;
-  else if (value == node->data)
-    return true;
-  else if (value < node->data)
-    return FindNode(node->left, value, compares);
-  else
-    return FindNode(node->right, value, compares);
+    if (node == nullptr)
+      return false;
+    else if (value == node->data)
+      return true;
+    else if (value < node->data)
+      node = node->left;
+    else
+      node = node->right;
+  }
 }
 
 /**
- * @brief Finds the node at the specified index in the binary search tree.
+ * @brief Builds a perfectly balanced tree from the next n values of a
+ * sorted range: the left half, then the middle value, then the right half.
+ * The right half gets the extra value when n is even.
  * 
- * This function recursively searches for the node at the given index in the binary search tree.
- * The index represents the position of the node in an inorder traversal of the tree.
+ * @tparam Iterator A forward iterator over values of type T.
+ * @param next The next value to use; advanced past the values used.
+ * @param last One past the last value of the range.
+ * @param n The number of values to use.
+ * @param unique Whether to use one copy of each value, skipping the rest.
+ * @return The root of the new subtree, nullptr if n is 0.
+ * @throws BSTException if a node cannot be allocated. The nodes made so far are freed.
+ */
+template <typename T>
+template <typename Iterator>
+typename BSTree<T>::BinTree BSTree<T>::BuildBalanced(Iterator &next, Iterator last, size_t n, bool unique)
+{
+  if (n == 0)
+    return nullptr;
+
+  const size_t left_size = (n - 1) / 2;
+  const size_t right_size = n - 1 - left_size;
+  BinTree left = BuildBalanced(next, last, left_size, unique);
+  BinTree node = nullptr;
+
+  try
+  {
+    node = make_node(*next);
+    node->left = left;
+
+    // Skip the copies of this value if only one is kept
+    Iterator value = next;
+    while (++next != last && unique && !(*value < *next))
+      ;
+
+    node->right = BuildBalanced(next, last, right_size, unique);
+  }
+  catch (...)
+  {
+    if (node)
+      free_node(node);
+    FreeSubtree(left);
+    throw;
+  }
+
+  node->count = static_cast<unsigned>(n);
+  node->balance_factor = BalancedHeight(right_size) - BalancedHeight(left_size);
+  return node;
+}
+
+/**
+ * @brief Returns the height of a perfectly balanced tree of n nodes.
  * 
- * @param tree The binary search tree.
- * @param index The index of the node to find.
- * @return The node at the specified index, or nullptr if the index is out of range.
+ * @param n The number of nodes.
+ * @return floor(log2(n)), or -1 for an empty tree.
  */
 template <typename T>
-typename BSTree<T>::BinTree BSTree<T>::FindNodeAtIndex(BinTree tree, unsigned index) const
+int BSTree<T>::BalancedHeight(size_t n)
 {
-  return FindNodeAtIndexRecursive(tree, index);
+  int height = -1;
+  for (; n != 0; n >>= 1)
+    ++height;
+  return height;
 }
 
 /**
- * @brief Recursively finds the node at the specified index in the binary search tree.
+ * @brief Looks up values in groups of BatchGroupSize, advancing each lookup
+ * of the group one level per round and prefetching the node it moves to.
+ * A lookup that finishes hands its slot to the next key, so the group stays
+ * full until the keys run out.
  * 
- * This function traverses the binary search tree in an inorder manner and returns the node
- * at the specified index. The index is zero-based, meaning the first node has an index of 0.
+ * @param keys The values to search for.
+ * @param n The number of values.
+ * @param out Set to true for each value found, false otherwise.
+ */
+template <typename T>
+void BSTree<T>::FindInterleaved(const T *keys, size_t n, bool *out) const
+{
+  size_t slots[BatchGroupSize]; // key of each lookup in flight
+  BinTree nodes[BatchGroupSize]; // node each lookup compares next
+  size_t live = 0;
+  size_t next = 0;
+
+  for (; live < BatchGroupSize && next < n; ++live, ++next)
+  {
+    slots[live] = next;
+    nodes[live] = rootNode;
+  }
+
+  while (live > 0)
+  {
+    for (size_t i = 0; i < live;)
+    {
+      const T &key = keys[slots[i]];
+      BinTree node = nodes[i];
+
+      if (node != nullptr && !(key == node->data))
+      {
+        node = key < node->data ? node->left : node->right;
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(node);
+#endif
+        nodes[i] = node;
+        ++i;
+        continue;
+      }
+
+      out[slots[i]] = node != nullptr;
+      if (next < n)
+      {
+        slots[i] = next++;
+        nodes[i] = rootNode;
+        ++i;
+      }
+      else
+      {
+        --live;
+        slots[i] = slots[live];
+        nodes[i] = nodes[live];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Counts the values less than a value, adding up the counts of the
+ * subtrees passed on the left on the way down.
  * 
- * @param tree The binary search tree to search in.
+ * @param value The value to compare with.
+ * @return The number of values less than value.
+ */
+template <typename T>
+unsigned int BSTree<T>::CountLess(const T &value) const
+{
+  unsigned int less = 0;
+  for (BinTree tree = rootNode; tree != nullptr;)
+  {
+    if (tree->data < value)
+    {
+      less += CountLeftSubtreeNodes(tree) + 1;
+      tree = tree->right;
+    }
+    else
+      tree = tree->left;
+  }
+  return less;
+}
+
+/**
+ * @brief Finds the node at the specified index in the binary search tree.
+ * 
+ * This function walks down the binary search tree to the node at the given index, using the
+ * subtree counts to choose a side at each node.
+ * The index represents the position of the node in an inorder traversal of the tree.
+ * 
+ * @param tree The binary search tree.
  * @param index The index of the node to find.
  * @return The node at the specified index, or nullptr if the index is out of range.
  */
 template <typename T>
-typename BSTree<T>::BinTree BSTree<T>::FindNodeAtIndexRecursive(BinTree tree, unsigned index) const
+typename BSTree<T>::BinTree BSTree<T>::FindNodeAtIndex(BinTree tree, unsigned index) const
 {
-  if (tree == nullptr)
-    return nullptr;
+  while (tree != nullptr)
+  {
+    unsigned int left_count = CountLeftSubtreeNodes(tree);
 
-  unsigned int left_count = CountLeftSubtreeNodes(tree);
+    if (left_count > index)
+      tree = tree->left;
+    else if (left_count < index)
+    {
+      index -= left_count + 1;
+      tree = tree->right;
+    }
+    else
+      return tree;
+  }
 
-  if (left_count > index)
-    return FindNodeAtIndexRecursive(tree->left, index);
-  else if (left_count < index)
-    return FindNodeAtIndexRecursive(tree->right, index - left_count - 1);
-  else
-    return tree;
+  return nullptr;
 }
 
 /**
@@ -731,3 +1203,101 @@ unsigned int BSTree<T>::CountLeftSubtreeNodes(BinTree tree) const
   else
     return 0;
 }
+
+/**
+ * @brief Constructs the end iterator.
+ */
+template <typename T>
+BSTree<T>::const_iterator::const_iterator() : path()
+{
+}
+
+/**
+ * @brief Returns the current value.
+ * 
+ * @return The value. The iterator must not be the end iterator.
+ */
+template <typename T>
+typename BSTree<T>::const_iterator::reference BSTree<T>::const_iterator::operator*() const
+{
+  return path.back()->data;
+}
+
+/**
+ * @brief Gives access to the current value.
+ * 
+ * @return A pointer to the value. The iterator must not be the end iterator.
+ */
+template <typename T>
+typename BSTree<T>::const_iterator::pointer BSTree<T>::const_iterator::operator->() const
+{
+  return &path.back()->data;
+}
+
+/**
+ * @brief Moves to the next value: the leftmost node of the right subtree,
+ * or else the nearest ancestor still to be visited. Amortized O(1).
+ * 
+ * @return This iterator.
+ */
+template <typename T>
+typename BSTree<T>::const_iterator &BSTree<T>::const_iterator::operator++()
+{
+  const BinTreeNode *node = path.back();
+  path.pop_back();
+  PushLeftmost(node->right);
+  return *this;
+}
+
+/**
+ * @brief Moves to the next value.
+ * 
+ * @return A copy of the iterator from before the move.
+ */
+template <typename T>
+typename BSTree<T>::const_iterator BSTree<T>::const_iterator::operator++(int)
+{
+  const_iterator before(*this);
+  ++*this;
+  return before;
+}
+
+/**
+ * @brief Checks if two iterators are at the same value.
+ * 
+ * @param rhs The other iterator.
+ * @return true if both are at the same node, or both are end iterators.
+ */
+template <typename T>
+bool BSTree<T>::const_iterator::operator==(const const_iterator &rhs) const
+{
+  if (path.empty() || rhs.path.empty())
+    return path.empty() && rhs.path.empty();
+
+  return path.back() == rhs.path.back();
+}
+
+/**
+ * @brief Checks if two iterators are at different values.
+ * 
+ * @param rhs The other iterator.
+ * @return true if they are not equal.
+ */
+template <typename T>
+bool BSTree<T>::const_iterator::operator!=(const const_iterator &rhs) const
+{
+  return !(*this == rhs);
+}
+
+/**
+ * @brief Pushes a node and its chain of left children, leaving the
+ * smallest value of the subtree on top.
+ * 
+ * @param node The root of the subtree, may be nullptr.
+ */
+template <typename T>
+void BSTree<T>::const_iterator::PushLeftmost(const BinTreeNode *node)
+{
+  for (; node != nullptr; node = node->left)
+    path.push_back(node);
+}
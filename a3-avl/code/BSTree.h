@@ -14,10 +14,15 @@
 #ifndef BSTREE_H
 #define BSTREE_H
 //---------------------------------------------------------------------------
-#include <string>    // std::string
-#include <stdexcept> // std::exception
+#include <cstddef>     // size_t, std::ptrdiff_t
+#include <iterator>    // std::forward_iterator_tag, std::iterator_traits
+#include <string>      // std::string
+#include <stdexcept>   // std::exception
+#include <type_traits> // std::is_base_of
+#include <vector>      // std::vector
 
 #include "ObjectAllocator.h"
+#include "EytzingerIndex.h"
 
 /*!
   The exception class for the AVL/BST classes
@@ -95,7 +100,85 @@ class BSTree
     //! shorthand
     using BinTree = BinTreeNode*;
 
-    BSTree(ObjectAllocator *oa = 0, bool ShareOA = false);
+    //! Visits the values in sorted order; invalidated by any change to the tree
+    class const_iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator();
+        reference operator*() const;
+        pointer operator->() const;
+        const_iterator& operator++();
+        const_iterator operator++(int);
+        bool operator==(const const_iterator& rhs) const;
+        bool operator!=(const const_iterator& rhs) const;
+
+      private:
+        friend class BSTree;
+
+        //! Nodes kept in the iterator itself: enough for any AVL tree (see
+        //! AVLTree::MaxPathLength) or balanced BSTree
+        static const size_t InlinePathLength = 48;
+
+        //! A stack of nodes that only goes to the heap past InlinePathLength,
+        //! which takes a degenerate BSTree
+        struct Path
+        {
+          const BinTreeNode* nodes[InlinePathLength]; //!< nodes[0] is the bottom
+          std::vector<const BinTreeNode*> overflow;   //!< the nodes above InlinePathLength
+          size_t size = 0;                            //!< nodes in use
+
+          Path() {}
+          Path(const Path& rhs) : overflow(rhs.overflow), size(rhs.size) { CopyNodes(rhs); }
+          Path& operator=(const Path& rhs)
+          {
+            overflow = rhs.overflow;
+            size = rhs.size;
+            CopyNodes(rhs);
+            return *this;
+          }
+
+          bool empty() const { return size == 0; }
+          const BinTreeNode* back() const
+          {
+            return size > InlinePathLength ? overflow.back() : nodes[size - 1];
+          }
+          void push_back(const BinTreeNode* node)
+          {
+            if (size < InlinePathLength)
+              nodes[size] = node;
+            else
+              overflow.push_back(node);
+            ++size;
+          }
+          void pop_back()
+          {
+            if (size > InlinePathLength)
+              overflow.pop_back();
+            --size;
+          }
+
+          private:
+            //! Copies the nodes in use, the rest are never read
+            void CopyNodes(const Path& rhs)
+            {
+              for (size_t i = 0; i < size && i < InlinePathLength; ++i)
+                nodes[i] = rhs.nodes[i];
+            }
+        };
+
+        //! The current node on top, below it the ancestors still to be visited
+        Path path;
+
+        void PushLeftmost(const BinTreeNode* node);
+    };
+
+    BSTree(ObjectAllocator *oa = 0, bool ShareOA = false, unsigned ExpectedSize = 0);
     BSTree(const BSTree& rhs);
     virtual ~BSTree();
     BSTree& operator=(const BSTree& rhs);
@@ -103,11 +186,21 @@ class BSTree
     virtual void insert(const T& value);
     virtual void remove(const T& value);
     void clear();
+    void reserve(unsigned n); // preallocate nodes for n items
+    template <typename Iterator>
+    void build_from_sorted(Iterator first, Iterator last); // replace contents in O(n)
     bool find(const T& value, unsigned &compares) const;
+    void find_batch(const T* keys, size_t n, bool* out, unsigned threads = 1) const;
     bool empty() const;
     unsigned int size() const;
     int height() const;
     BinTree root() const;
+    EytzingerIndex<T> freeze() const; // read-only search index of the values
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator lower_bound(const T& value) const; // first value not less than value
+    const_iterator upper_bound(const T& value) const; // first value greater than value
+    unsigned int count_range(const T& lo, const T& hi) const; // values in [lo, hi)
 
   protected:
     BinTree& get_root();
@@ -115,6 +208,7 @@ class BSTree
     void free_node(BinTree node);
     int tree_height(BinTree tree) const;
     void find_predecessor(BinTree tree, BinTree &predecessor) const;
+    virtual bool unique_values() const; // insert keeps one copy of each value
 
     BinTree rootNode;
     unsigned int sizeOfTree;
@@ -124,8 +218,19 @@ class BSTree
     bool shareOA;
 
   private:
+    //! Nodes per page of the tree's own allocator when no size is expected
+    static const unsigned DefaultNodesPerPage = 256;
+    //! Smallest and largest page of the tree's own allocator, in nodes
+    static const unsigned MinNodesPerPage = 16;
+    static const unsigned MaxNodesPerPage = 4096;
+    //! Lookups find_batch keeps in flight on each thread
+    static const unsigned BatchGroupSize = 8;
+    //! Fewest keys find_batch gives a thread of its own
+    static const size_t MinKeysPerThread = 4096;
+
     // private stuff...
-    void InitializeAllocator(ObjectAllocator* oa, bool shareOA);
+    static ObjectAllocator* CreateAllocator(unsigned expectedSize);
+    void InitializeAllocator(ObjectAllocator* oa, bool shareOA, unsigned expectedSize = 0);
     void CopyTree(const BinTree& source, BinTree& dest);
     void HandleObjectAllocator(const BSTree& rhs);
     void FreeTree(BinTree tree);
@@ -139,8 +244,12 @@ class BSTree
     void ReplaceNodeWithRightChild(BinTree& node);
     void ReplaceNodeWithLeftChild(BinTree& node);
     bool FindNode(BinTree node, const T& value, unsigned& compares) const;
+    void FindInterleaved(const T* keys, size_t n, bool* out) const;
+    template <typename Iterator>
+    BinTree BuildBalanced(Iterator &next, Iterator last, size_t n, bool unique);
+    static int BalancedHeight(size_t n);
+    unsigned int CountLess(const T& value) const;
     BinTree FindNodeAtIndex(BinTree tree, unsigned index) const;
-    BinTree FindNodeAtIndexRecursive(BinTree tree, unsigned index) const;
     unsigned int CountLeftSubtreeNodes(BinTree tree) const;
     BinTree AllocateMemory() const;
     BinTree CreateNode(BinTree alloc, const T& value) const;
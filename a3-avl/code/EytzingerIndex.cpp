@@ -0,0 +1,141 @@
+/*!******************************************************************
+ * \file      EytzingerIndex.cpp
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course:
+ * \par       Section:
+ * \par
+ * \date      29-02-2024
+ *
+ * \brief     This file contains the implementation for the EytzingerIndex
+ *            class.
+ *********************************************************************/
+/******************************************************************************/
+#include "EytzingerIndex.h"
+
+/**
+ * @brief Constructs an empty index.
+ */
+template <typename T>
+EytzingerIndex<T>::EytzingerIndex() : values(1)
+{
+}
+
+/**
+ * @brief Constructs an index of sorted values.
+ *
+ * The positions of a complete tree of n nodes are visited in order (an
+ * in-order walk that moves by index arithmetic, without a stack) and given
+ * the sorted values one by one.
+ *
+ * @param sorted The values, in ascending order.
+ */
+template <typename T>
+EytzingerIndex<T>::EytzingerIndex(const std::vector<T> &sorted) : values(sorted.size() + 1)
+{
+  const std::size_t n = sorted.size();
+  if (n == 0)
+    return;
+
+  // Leftmost position
+  std::size_t k = 1;
+  while (2 * k <= n)
+    k *= 2;
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    values[k] = sorted[i];
+
+    // In-order successor: the leftmost of the right subtree, or else the
+    // nearest ancestor this is in the left subtree of
+    if (2 * k + 1 <= n)
+    {
+      k = 2 * k + 1;
+      while (2 * k <= n)
+        k *= 2;
+    }
+    else
+    {
+      while (k & 1)
+        k >>= 1;
+      k >>= 1;
+    }
+  }
+}
+
+/**
+ * @brief Finds a value in the index.
+ *
+ * The search always runs to the bottom of the implicit tree, taking the
+ * right child when the value there is smaller, which ends at the first
+ * value not less than the one searched for. compares is then what
+ * BSTree::find would count on the implicit tree: the nodes down to a match,
+ * or every node on the path plus one for the empty subtree on a miss.
+ *
+ * @param value The value to search for.
+ * @param compares The number of comparisons made during the search.
+ * @return true if the value is found, false otherwise.
+ */
+template <typename T>
+bool EytzingerIndex<T>::find(const T &value, unsigned &compares) const
+{
+  // The 16 descendants four levels down from k are 16k to 16k + 15, next to
+  // each other: one 64-byte line for a 4-byte T, the first of several for a
+  // larger one. The distance is in levels, whatever the size of T.
+  const unsigned PrefetchLevels = 4;
+  const std::size_t n = values.size() - 1;
+  const T *base = values.data();
+
+  std::size_t k = 1;
+  unsigned levels = 0;
+  while (k <= n)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    std::size_t ahead = k << PrefetchLevels;
+    __builtin_prefetch(base + (ahead <= n ? ahead : n));
+#endif
+    k = 2 * k + (base[k] < value);
+    ++levels;
+  }
+
+  // Undo the right turns taken after the last left turn: that node is the
+  // first value not less than the one searched for
+  while (k & 1)
+    k >>= 1;
+  k >>= 1;
+
+  if (k != 0 && !(value < base[k]))
+  {
+    // Depth of k, plus one
+    unsigned depth = 0;
+    for (std::size_t i = k; i > 1; i >>= 1)
+      ++depth;
+    compares += depth + 1;
+    return true;
+  }
+
+  compares += levels + 1;
+  return false;
+}
+
+/**
+ * @brief Checks if the index is empty.
+ *
+ * @return true if the index holds no values, false otherwise.
+ */
+template <typename T>
+bool EytzingerIndex<T>::empty() const
+{
+  return values.size() == 1;
+}
+
+/**
+ * @brief Returns the number of values in the index.
+ *
+ * @return The number of values.
+ */
+template <typename T>
+unsigned int EytzingerIndex<T>::size() const
+{
+  return static_cast<unsigned int>(values.size() - 1);
+}
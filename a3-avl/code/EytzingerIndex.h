@@ -0,0 +1,47 @@
+/*!******************************************************************
+ * \file      EytzingerIndex.h
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course:
+ * \par       Section:
+ * \par
+ * \date      29-02-2024
+ *
+ * \brief     This file contains the definition for the EytzingerIndex
+ *            class, a read-only search index made by BSTree::freeze.
+ *********************************************************************/
+/******************************************************************************/
+//---------------------------------------------------------------------------
+#ifndef EYTZINGERINDEX_H
+#define EYTZINGERINDEX_H
+//---------------------------------------------------------------------------
+#include <cstddef> // std::size_t
+#include <vector>  // std::vector
+
+/*!
+  An immutable set of values laid out in Eytzinger (breadth-first) order:
+  the values are those of a complete binary search tree stored level by
+  level, so the children of position k are 2k and 2k + 1 and no links are
+  needed. The top levels share a few cache lines, a search picks the next
+  child without a branch, and the line holding the descendants four levels
+  down is prefetched while the current one is compared.
+*/
+template <typename T>
+class EytzingerIndex
+{
+  public:
+    EytzingerIndex();
+    EytzingerIndex(const std::vector<T>& sorted); // values in ascending order
+
+    bool find(const T& value, unsigned &compares) const;
+    bool empty() const;
+    unsigned int size() const;
+
+  private:
+    std::vector<T> values; //!< values[1..n] in Eytzinger order, values[0] unused
+};
+
+#include "EytzingerIndex.cpp"
+
+#endif
+//---------------------------------------------------------------------------
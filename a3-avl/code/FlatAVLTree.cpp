@@ -0,0 +1,544 @@
+/*!******************************************************************
+ * \file      FlatAVLTree.cpp
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course:
+ * \par       Section:
+ * \par
+ * \date      29-02-2024
+ *
+ * \brief     This file contains the implementation for the FlatAVLTree
+ *            class.
+ *********************************************************************/
+/******************************************************************************/
+#include "FlatAVLTree.h"
+#include <new> // std::bad_alloc
+
+/**
+ * @brief Constructs an empty FlatAVLTree.
+ *
+ * @param ExpectedSize Roughly how many items the tree will hold (0 if unknown). Room for that
+ *        many nodes is reserved up front.
+ * @throws BSTException if the memory cannot be allocated.
+ */
+template <typename T>
+FlatAVLTree<T>::FlatAVLTree(unsigned ExpectedSize)
+    : nodes(), rootIndex(Nil), freeList(Nil), sizeOfTree(0)
+{
+  reserve(ExpectedSize);
+}
+
+/**
+ * @brief Inserts a value into the tree, unless it is already there.
+ *
+ * The path down from the root is recorded as node indices rather than
+ * pointers, since adding the node may move the vector.
+ *
+ * @param value The value to be inserted.
+ * @throws BSTException if the node cannot be allocated.
+ */
+template <typename T>
+void FlatAVLTree<T>::insert(const T &value)
+{
+  std::uint32_t path[MaxPathLength];
+  bool wentRight[MaxPathLength];
+  int depth = 0;
+
+  for (std::uint32_t node = rootIndex; node != Nil; ++depth)
+  {
+    path[depth] = node;
+    if (value < nodes[node].data)
+      wentRight[depth] = false;
+    else if (value > nodes[node].data)
+      wentRight[depth] = true;
+    else
+      return;
+    node = wentRight[depth] ? Right(node) : Left(node);
+  }
+
+  Link(path, wentRight, depth, MakeNode(value));
+  ++sizeOfTree;
+  for (int i = 0; i < depth; ++i)
+    ++nodes[path[i]].count;
+
+  // Walk back up until a subtree's height is unchanged or one rotation fixes it
+  while (depth > 0)
+  {
+    --depth;
+    std::uint32_t node = path[depth];
+    int balance = Balance(node) + (wentRight[depth] ? 1 : -1);
+
+    if (balance == 2 || balance == -2)
+    {
+      bool shorter;
+      Link(path, wentRight, depth, balance > 0 ? RightBalance(node, shorter) : LeftBalance(node, shorter));
+      return;
+    }
+
+    SetBalance(node, balance);
+    if (balance == 0)
+      return;
+  }
+}
+
+/**
+ * @brief Removes a value from the tree, if it is there.
+ *
+ * A node with two children takes its predecessor's data and the predecessor
+ * is unlinked instead. The freed node is reused by a later insert.
+ *
+ * @param value The value to be removed.
+ */
+template <typename T>
+void FlatAVLTree<T>::remove(const T &value)
+{
+  std::uint32_t path[MaxPathLength];
+  bool wentRight[MaxPathLength];
+  int depth = 0;
+
+  std::uint32_t node = rootIndex;
+  while (node != Nil && (value < nodes[node].data || value > nodes[node].data))
+  {
+    path[depth] = node;
+    wentRight[depth] = !(value < nodes[node].data);
+    node = wentRight[depth++] ? Right(node) : Left(node);
+  }
+
+  if (node == Nil)
+    return;
+
+  if (Left(node) != Nil && Right(node) != Nil)
+  {
+    std::uint32_t target = node;
+    path[depth] = target;
+    wentRight[depth++] = false;
+    node = Left(target);
+    while (Right(node) != Nil)
+    {
+      path[depth] = node;
+      wentRight[depth++] = true;
+      node = Right(node);
+    }
+    nodes[target].data = nodes[node].data;
+  }
+
+  Link(path, wentRight, depth, Left(node) != Nil ? Left(node) : Right(node));
+  FreeNode(node);
+  --sizeOfTree;
+  for (int i = 0; i < depth; ++i)
+    --nodes[path[i]].count;
+
+  // Walk back up while the subtree keeps getting shorter
+  while (depth > 0)
+  {
+    --depth;
+    node = path[depth];
+    int balance = Balance(node) + (wentRight[depth] ? -1 : 1);
+
+    if (balance == 2 || balance == -2)
+    {
+      bool shorter;
+      Link(path, wentRight, depth, balance > 0 ? RightBalance(node, shorter) : LeftBalance(node, shorter));
+      if (!shorter)
+        return;
+      continue;
+    }
+
+    SetBalance(node, balance);
+    if (balance != 0)
+      return;
+  }
+}
+
+/**
+ * @brief Removes every node. The memory is kept for reuse.
+ */
+template <typename T>
+void FlatAVLTree<T>::clear()
+{
+  nodes.clear();
+  rootIndex = Nil;
+  freeList = Nil;
+  sizeOfTree = 0;
+}
+
+/**
+ * @brief Reserves room for n nodes, so the tree can grow to that size
+ * without the vector moving.
+ *
+ * @param n The number of items the tree should be able to hold.
+ * @throws BSTException if the memory cannot be allocated.
+ */
+template <typename T>
+void FlatAVLTree<T>::reserve(unsigned n)
+{
+  try
+  {
+    nodes.reserve(n);
+  }
+  catch (const std::bad_alloc &except)
+  {
+    throw(BSTException(BSTException::E_NO_MEMORY, except.what()));
+  }
+}
+
+/**
+ * @brief Finds a value in the tree.
+ *
+ * compares counts one for each node visited, plus one for the empty subtree
+ * where an unsuccessful search ends, as BSTree::find does.
+ *
+ * @param value The value to search for.
+ * @param compares The number of comparisons made during the search.
+ * @return true if the value is found, false otherwise.
+ */
+template <typename T>
+bool FlatAVLTree<T>::find(const T &value, unsigned &compares) const
+{
+  std::uint32_t node = rootIndex;
+  while (true)
+  {
+    ++compares;
+
+    if (node == Nil)
+      return false;
+    else if (value == nodes[node].data)
+      return true;
+    else
+      node = value < nodes[node].data ? Left(node) : Right(node);
+  }
+}
+
+/**
+ * @brief Returns the node at the specified position in sorted order.
+ *
+ * @param index The index of the node to find.
+ * @return The node, or nullptr if the index is out of range. It is valid until the tree changes.
+ */
+template <typename T>
+const typename FlatAVLTree<T>::Node *FlatAVLTree<T>::operator[](int index) const
+{
+  if (index < 0 || static_cast<unsigned>(index) >= sizeOfTree)
+    return nullptr;
+
+  std::uint32_t position = static_cast<std::uint32_t>(index);
+  std::uint32_t node = rootIndex;
+  while (true)
+  {
+    std::uint32_t left_count = Count(Left(node));
+
+    if (left_count > position)
+      node = Left(node);
+    else if (left_count < position)
+    {
+      position -= left_count + 1;
+      node = Right(node);
+    }
+    else
+      return &nodes[node];
+  }
+}
+
+/**
+ * @brief Checks if the tree is empty.
+ *
+ * @return true if the tree is empty, false otherwise.
+ */
+template <typename T>
+bool FlatAVLTree<T>::empty() const
+{
+  return sizeOfTree == 0;
+}
+
+/**
+ * @brief Returns the number of elements in the tree.
+ *
+ * @return The number of elements in the tree.
+ */
+template <typename T>
+unsigned int FlatAVLTree<T>::size() const
+{
+  return sizeOfTree;
+}
+
+/**
+ * @brief Returns the height of the tree, in O(log n): the balance factors
+ * lead down one of the longest paths.
+ *
+ * @return The height of the tree, -1 if it is empty.
+ */
+template <typename T>
+int FlatAVLTree<T>::height() const
+{
+  int height = -1;
+  for (std::uint32_t node = rootIndex; node != Nil; ++height)
+    node = Balance(node) > 0 ? Right(node) : Left(node);
+  return height;
+}
+
+/**
+ * @brief Returns the left child of a node.
+ *
+ * @param node The node.
+ * @return The left child index, Nil if none.
+ */
+template <typename T>
+std::uint32_t FlatAVLTree<T>::Left(std::uint32_t node) const
+{
+  return nodes[node].left;
+}
+
+/**
+ * @brief Returns the right child of a node.
+ *
+ * @param node The node.
+ * @return The right child index, Nil if none.
+ */
+template <typename T>
+std::uint32_t FlatAVLTree<T>::Right(std::uint32_t node) const
+{
+  return nodes[node].right;
+}
+
+/**
+ * @brief Sets the left child of a node.
+ *
+ * @param node The node.
+ * @param child The new left child index, or Nil.
+ */
+template <typename T>
+void FlatAVLTree<T>::SetLeft(std::uint32_t node, std::uint32_t child)
+{
+  nodes[node].left = child;
+}
+
+/**
+ * @brief Sets the right child of a node.
+ *
+ * @param node The node.
+ * @param child The new right child index, or Nil.
+ */
+template <typename T>
+void FlatAVLTree<T>::SetRight(std::uint32_t node, std::uint32_t child)
+{
+  nodes[node].right = child;
+}
+
+/**
+ * @brief Returns the balance factor of a node: the height of its right
+ * subtree minus the height of its left.
+ *
+ * @param node The node.
+ * @return -1, 0 or 1.
+ */
+template <typename T>
+int FlatAVLTree<T>::Balance(std::uint32_t node) const
+{
+  return static_cast<int>(nodes[node].count >> 30) - 1;
+}
+
+/**
+ * @brief Sets the balance factor of a node.
+ *
+ * @param node The node.
+ * @param balance -1, 0 or 1.
+ */
+template <typename T>
+void FlatAVLTree<T>::SetBalance(std::uint32_t node, int balance)
+{
+  nodes[node].count = (nodes[node].count & CountMask) | (static_cast<std::uint32_t>(balance + 1) << 30);
+}
+
+/**
+ * @brief Returns the number of nodes in a subtree.
+ *
+ * @param node The root of the subtree, or Nil.
+ * @return The node count, 0 for an empty subtree.
+ */
+template <typename T>
+std::uint32_t FlatAVLTree<T>::Count(std::uint32_t node) const
+{
+  return node == Nil ? 0 : nodes[node].count & CountMask;
+}
+
+/**
+ * @brief Sets the number of nodes in a subtree, keeping its balance factor.
+ *
+ * @param node The root of the subtree.
+ * @param count The node count.
+ */
+template <typename T>
+void FlatAVLTree<T>::SetCount(std::uint32_t node, std::uint32_t count)
+{
+  nodes[node].count = (nodes[node].count & ~CountMask) | count;
+}
+
+/**
+ * @brief Takes a free node, or adds one to the end of the vector, and
+ * makes it a leaf holding the value.
+ *
+ * @param value The value to be stored in the node.
+ * @return The index of the node.
+ * @throws BSTException if the node cannot be allocated.
+ */
+template <typename T>
+std::uint32_t FlatAVLTree<T>::MakeNode(const T &value)
+{
+  const Node leaf = {value, Nil, Nil, 1u | (1u << 30)};
+
+  if (freeList != Nil)
+  {
+    std::uint32_t node = freeList;
+    freeList = nodes[node].right;
+    nodes[node] = leaf;
+    return node;
+  }
+
+  if (nodes.size() >= Nil)
+    throw(BSTException(BSTException::E_NO_MEMORY, "Too many nodes for 30-bit indices"));
+
+  try
+  {
+    nodes.push_back(leaf);
+  }
+  catch (const std::bad_alloc &except)
+  {
+    throw(BSTException(BSTException::E_NO_MEMORY, except.what()));
+  }
+  return static_cast<std::uint32_t>(nodes.size() - 1);
+}
+
+/**
+ * @brief Puts a node on the free list.
+ *
+ * @param node The node, no longer linked into the tree.
+ */
+template <typename T>
+void FlatAVLTree<T>::FreeNode(std::uint32_t node)
+{
+  nodes[node].right = freeList;
+  freeList = node;
+}
+
+/**
+ * @brief Stores a subtree in the link at a position on a recorded path.
+ *
+ * @param path The nodes from the root down.
+ * @param wentRight Which child was taken from each node on the path.
+ * @param depth The position: 0 for the root, else the child of path[depth - 1].
+ * @param child The subtree, or Nil.
+ */
+template <typename T>
+void FlatAVLTree<T>::Link(const std::uint32_t *path, const bool *wentRight, int depth, std::uint32_t child)
+{
+  if (depth == 0)
+    rootIndex = child;
+  else if (wentRight[depth - 1])
+    SetRight(path[depth - 1], child);
+  else
+    SetLeft(path[depth - 1], child);
+}
+
+/**
+ * @brief Rotates a subtree left. Counts are updated; balance factors are
+ * left to the caller.
+ *
+ * @param node The root of the subtree.
+ * @return The new root of the subtree (the old right child).
+ */
+template <typename T>
+std::uint32_t FlatAVLTree<T>::LeftRotate(std::uint32_t node)
+{
+  std::uint32_t right_child = Right(node);
+  SetRight(node, Left(right_child));
+  SetLeft(right_child, node);
+
+  SetCount(right_child, Count(node));
+  SetCount(node, 1 + Count(Left(node)) + Count(Right(node)));
+  return right_child;
+}
+
+/**
+ * @brief Rotates a subtree right. Counts are updated; balance factors are
+ * left to the caller.
+ *
+ * @param node The root of the subtree.
+ * @return The new root of the subtree (the old left child).
+ */
+template <typename T>
+std::uint32_t FlatAVLTree<T>::RightRotate(std::uint32_t node)
+{
+  std::uint32_t left_child = Left(node);
+  SetLeft(node, Right(left_child));
+  SetRight(left_child, node);
+
+  SetCount(left_child, Count(node));
+  SetCount(node, 1 + Count(Left(node)) + Count(Right(node)));
+  return left_child;
+}
+
+/**
+ * @brief Rebalances a subtree whose right side is two levels taller than its
+ * left, with a single or double rotation, and sets the new balance factors.
+ *
+ * @param node The root of the subtree.
+ * @param shorter Set to true if the subtree is now one level shorter, false if
+ *        its height is unchanged (only possible after a removal).
+ * @return The new root of the subtree.
+ */
+template <typename T>
+std::uint32_t FlatAVLTree<T>::RightBalance(std::uint32_t node, bool &shorter)
+{
+  std::uint32_t right_child = Right(node);
+  int right_balance = Balance(right_child);
+
+  if (right_balance >= 0)
+  {
+    shorter = right_balance != 0;
+    SetBalance(node, right_balance ? 0 : 1);
+    SetBalance(right_child, right_balance ? 0 : -1);
+    return LeftRotate(node);
+  }
+
+  std::uint32_t grandchild = Left(right_child);
+  int grandchild_balance = Balance(grandchild);
+  shorter = true;
+  SetBalance(node, grandchild_balance > 0 ? -1 : 0);
+  SetBalance(right_child, grandchild_balance < 0 ? 1 : 0);
+  SetBalance(grandchild, 0);
+  SetRight(node, RightRotate(right_child));
+  return LeftRotate(node);
+}
+
+/**
+ * @brief Rebalances a subtree whose left side is two levels taller than its
+ * right. Mirrors RightBalance.
+ *
+ * @param node The root of the subtree.
+ * @param shorter Set to true if the subtree is now one level shorter, false if
+ *        its height is unchanged (only possible after a removal).
+ * @return The new root of the subtree.
+ */
+template <typename T>
+std::uint32_t FlatAVLTree<T>::LeftBalance(std::uint32_t node, bool &shorter)
+{
+  std::uint32_t left_child = Left(node);
+  int left_balance = Balance(left_child);
+
+  if (left_balance <= 0)
+  {
+    shorter = left_balance != 0;
+    SetBalance(node, left_balance ? 0 : -1);
+    SetBalance(left_child, left_balance ? 0 : 1);
+    return RightRotate(node);
+  }
+
+  std::uint32_t grandchild = Right(left_child);
+  int grandchild_balance = Balance(grandchild);
+  shorter = true;
+  SetBalance(node, grandchild_balance < 0 ? 1 : 0);
+  SetBalance(left_child, grandchild_balance > 0 ? -1 : 0);
+  SetBalance(grandchild, 0);
+  SetLeft(node, LeftRotate(left_child));
+  return RightRotate(node);
+}
@@ -0,0 +1,90 @@
+/*!******************************************************************
+ * \file      FlatAVLTree.h
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course:
+ * \par       Section:
+ * \par
+ * \date      29-02-2024
+ *
+ * \brief     This file contains the definition for the FlatAVLTree class,
+ *            an AVL tree whose nodes live in one vector and are linked
+ *            by 32-bit indices instead of pointers.
+ *********************************************************************/
+/******************************************************************************/
+//---------------------------------------------------------------------------
+#ifndef FLATAVLTREE_H
+#define FLATAVLTREE_H
+//---------------------------------------------------------------------------
+#include <cstdint>   // std::uint32_t
+#include <vector>    // std::vector
+#include "BSTree.h"  // BSTException
+
+/*!
+  An AVL tree with the same insert/remove/find/operator[] interface as
+  AVLTree, stored flat: nodes are kept in a contiguous vector and refer to
+  their children by index. A node holds the data, two 32-bit links and a
+  32-bit count, with the balance factor in the top bits of the count, so
+  for FlatAVLTree<int> it takes 16 bytes instead of 32 (plus the heap's
+  per-block overhead). Removed nodes are reused by later inserts.
+*/
+template <typename T>
+class FlatAVLTree
+{
+  public:
+    //! The node structure
+    struct Node
+    {
+      T data;              //!< The data
+      std::uint32_t left;  //!< left child index
+      std::uint32_t right; //!< right child index, or the next free node when unused
+      std::uint32_t count; //!< nodes in this subtree (low 30 bits), balance factor + 1 (top 2 bits)
+    };
+
+    FlatAVLTree(unsigned ExpectedSize = 0);
+    void insert(const T& value);
+    void remove(const T& value);
+    void clear();
+    void reserve(unsigned n);
+    bool find(const T& value, unsigned &compares) const;
+    const Node* operator[](int index) const;
+    bool empty() const;
+    unsigned int size() const;
+    int height() const;
+
+  private:
+    //! The empty link, and one more than the largest node index
+    static const std::uint32_t Nil = 0x3FFFFFFF;
+    //! The bits of Node::count that hold the count
+    static const std::uint32_t CountMask = 0x3FFFFFFF;
+    //! Longest root-to-leaf path, as in AVLTree
+    static const int MaxPathLength = 48;
+
+    std::vector<Node> nodes; //!< every node, in use or free
+    std::uint32_t rootIndex; //!< index of the root, Nil if empty
+    std::uint32_t freeList;  //!< first unused node, chained through right
+    unsigned int sizeOfTree; //!< nodes in the tree
+
+    std::uint32_t Left(std::uint32_t node) const;
+    std::uint32_t Right(std::uint32_t node) const;
+    void SetLeft(std::uint32_t node, std::uint32_t child);
+    void SetRight(std::uint32_t node, std::uint32_t child);
+    int Balance(std::uint32_t node) const;
+    void SetBalance(std::uint32_t node, int balance);
+    std::uint32_t Count(std::uint32_t node) const;
+    void SetCount(std::uint32_t node, std::uint32_t count);
+
+    std::uint32_t MakeNode(const T& value);
+    void FreeNode(std::uint32_t node);
+    void Link(const std::uint32_t *path, const bool *wentRight, int depth, std::uint32_t child);
+
+    std::uint32_t LeftRotate(std::uint32_t node);
+    std::uint32_t RightRotate(std::uint32_t node);
+    std::uint32_t RightBalance(std::uint32_t node, bool &shorter);
+    std::uint32_t LeftBalance(std::uint32_t node, bool &shorter);
+};
+
+#include "FlatAVLTree.cpp"
+
+#endif
+//---------------------------------------------------------------------------
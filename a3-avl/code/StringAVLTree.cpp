@@ -0,0 +1,206 @@
+/*!******************************************************************
+ * \file      StringAVLTree.cpp
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course:
+ * \par       Section:
+ * \par
+ * \date      29-02-2024
+ *
+ * \brief     This file contains the implementation for the StringAVLTree
+ *            class.
+ *********************************************************************/
+/******************************************************************************/
+#include "StringAVLTree.h"
+#include <new>     // std::bad_alloc
+#include <utility> // std::move
+
+/**
+ * @brief Constructs an empty StringAVLTree.
+ *
+ * @param ExpectedSize Roughly how many keys the tree will hold (0 if unknown). Room for that
+ *        many nodes is reserved up front.
+ * @throws BSTException if the memory cannot be allocated.
+ */
+StringAVLTree::StringAVLTree(unsigned ExpectedSize)
+    : tree(ExpectedSize), blocks(), blockNext(nullptr), blockFree(0)
+{
+}
+
+/**
+ * @brief Inserts a key into the tree, unless it is already there.
+ *
+ * The bytes after the prefix are stored first, so the node can point at
+ * them, and are given back if the key turns out to be in the tree already.
+ *
+ * @param value The key to be inserted.
+ * @throws BSTException if the memory cannot be allocated.
+ */
+void StringAVLTree::insert(const std::string &value)
+{
+  const std::size_t blockCount = blocks.size();
+  char *const next = blockNext;
+  const std::size_t freeBytes = blockFree;
+  const unsigned before = tree.size();
+
+  Key key = MakeKey(value);
+  try
+  {
+    if (key.rest)
+      key.rest = Store(key.rest, key.length - Key::PrefixLength);
+    tree.insert(key);
+  }
+  catch (...)
+  {
+    blocks.resize(blockCount);
+    blockNext = next;
+    blockFree = freeBytes;
+    throw;
+  }
+
+  if (tree.size() == before)
+  {
+    blocks.resize(blockCount);
+    blockNext = next;
+    blockFree = freeBytes;
+  }
+}
+
+/**
+ * @brief Removes a key from the tree, if it is there. Its bytes stay in
+ * their block until clear().
+ *
+ * @param value The key to be removed.
+ */
+void StringAVLTree::remove(const std::string &value)
+{
+  tree.remove(MakeKey(value));
+}
+
+/**
+ * @brief Removes every key and frees the blocks of key bytes.
+ */
+void StringAVLTree::clear()
+{
+  tree.clear();
+  blocks.clear();
+  blockNext = nullptr;
+  blockFree = 0;
+}
+
+/**
+ * @brief Reserves room for n nodes, so the tree can grow to that size
+ * without its node vector moving.
+ *
+ * @param n The number of keys the tree should be able to hold.
+ * @throws BSTException if the memory cannot be allocated.
+ */
+void StringAVLTree::reserve(unsigned n)
+{
+  tree.reserve(n);
+}
+
+/**
+ * @brief Finds a key in the tree.
+ *
+ * The key is packed once; compares counts nodes as FlatAVLTree::find does.
+ *
+ * @param value The key to search for.
+ * @param compares The number of comparisons made during the search.
+ * @return true if the key is found, false otherwise.
+ */
+bool StringAVLTree::find(const std::string &value, unsigned &compares) const
+{
+  return tree.find(MakeKey(value), compares);
+}
+
+/**
+ * @brief Checks if the tree is empty.
+ *
+ * @return true if the tree is empty, false otherwise.
+ */
+bool StringAVLTree::empty() const
+{
+  return tree.empty();
+}
+
+/**
+ * @brief Returns the number of keys in the tree.
+ *
+ * @return The number of keys in the tree.
+ */
+unsigned int StringAVLTree::size() const
+{
+  return tree.size();
+}
+
+/**
+ * @brief Returns the height of the tree.
+ *
+ * @return The height of the tree, -1 if it is empty.
+ */
+int StringAVLTree::height() const
+{
+  return tree.height();
+}
+
+/**
+ * @brief Makes the key for a string. rest points into the string itself;
+ * insert moves it into a block.
+ *
+ * @param value The string.
+ * @return The key.
+ * @throws BSTException if the string is 4 GiB or longer.
+ */
+StringAVLTree::Key StringAVLTree::MakeKey(const std::string &value)
+{
+  if (value.size() > 0xFFFFFFFFu)
+    throw(BSTException(BSTException::E_NO_MEMORY, "Key too long for a 32-bit length"));
+
+  Key key;
+  key.prefix = 0;
+  key.rest = value.size() > Key::PrefixLength ? value.data() + Key::PrefixLength : nullptr;
+  key.length = static_cast<std::uint32_t>(value.size());
+
+  for (std::uint32_t i = 0; i < Key::PrefixLength; ++i)
+  {
+    key.prefix <<= 8;
+    if (i < key.length)
+      key.prefix |= static_cast<unsigned char>(value[i]);
+  }
+  return key;
+}
+
+/**
+ * @brief Copies bytes to the end of the last block, starting a new block
+ * when they do not fit. A key longer than BlockSize gets a block of its own.
+ *
+ * @param bytes The bytes to copy.
+ * @param length The number of bytes.
+ * @return Where the copy is.
+ * @throws BSTException if a block cannot be allocated.
+ */
+char *StringAVLTree::Store(const char *bytes, std::size_t length)
+{
+  if (blocks.empty() || blockFree < length)
+  {
+    const std::size_t size = length > BlockSize ? length : BlockSize;
+    try
+    {
+      std::unique_ptr<char[]> block(new char[size]);
+      blocks.push_back(std::move(block));
+    }
+    catch (const std::bad_alloc &except)
+    {
+      throw(BSTException(BSTException::E_NO_MEMORY, except.what()));
+    }
+    blockNext = blocks.back().get();
+    blockFree = size;
+  }
+
+  char *copy = blockNext;
+  std::memcpy(copy, bytes, length);
+  blockNext += length;
+  blockFree -= length;
+  return copy;
+}
@@ -0,0 +1,107 @@
+/*!******************************************************************
+ * \file      StringAVLTree.h
+ * \author    Benjamin Lee
+ * \par       DP email: benjaminzhiyuan.lee\@digipen.edu.sg
+ * \par       Course:
+ * \par       Section:
+ * \par
+ * \date      29-02-2024
+ *
+ * \brief     This file contains the definition for the StringAVLTree
+ *            class, an AVL tree of strings for large dictionaries.
+ *********************************************************************/
+/******************************************************************************/
+//---------------------------------------------------------------------------
+#ifndef STRINGAVLTREE_H
+#define STRINGAVLTREE_H
+//---------------------------------------------------------------------------
+#include <cstddef>         // std::size_t
+#include <cstdint>         // std::uint32_t, std::uint64_t
+#include <cstring>         // std::memcmp
+#include <memory>          // std::unique_ptr
+#include <string>          // std::string
+#include <vector>          // std::vector
+#include "FlatAVLTree.h"   // FlatAVLTree, BSTException
+
+/*!
+  An AVL tree of std::string keys with the same insert/remove/find
+  interface as AVLTree<std::string>, built on FlatAVLTree. A node holds no
+  std::string: its key is the first 8 bytes packed into an integer, the
+  length, and a pointer to the remaining bytes, which are copied into
+  large blocks shared by the whole tree. Most comparisons are settled by
+  the packed prefixes alone, without touching the characters; keys of up
+  to 8 bytes use no block space at all. Blocks never move, so the
+  pointers stay valid until clear(). The bytes of removed keys are only
+  reclaimed by clear().
+*/
+class StringAVLTree
+{
+  public:
+    //! A key as stored in a node
+    struct Key
+    {
+      //! Bytes of a key packed into prefix
+      static const std::uint32_t PrefixLength = 8;
+
+      std::uint64_t prefix; //!< first PrefixLength bytes, big-endian, zero padded
+      const char *rest;     //!< the bytes after the prefix, nullptr if there are none
+      std::uint32_t length; //!< length of the whole key
+
+      friend bool operator==(const Key &lhs, const Key &rhs)
+      {
+        return lhs.prefix == rhs.prefix && lhs.length == rhs.length &&
+               (lhs.length <= PrefixLength ||
+                std::memcmp(lhs.rest, rhs.rest, lhs.length - PrefixLength) == 0);
+      }
+      friend bool operator<(const Key &lhs, const Key &rhs) { return Compare(lhs, rhs) < 0; }
+      friend bool operator>(const Key &lhs, const Key &rhs) { return Compare(lhs, rhs) > 0; }
+
+      /*!
+        Orders two keys as std::string does (bytes compared as unsigned char).
+
+        \return
+          Negative, zero or positive as lhs is less than, equal to or greater
+          than rhs.
+      */
+      static int Compare(const Key &lhs, const Key &rhs)
+      {
+        if (lhs.prefix != rhs.prefix)
+          return lhs.prefix < rhs.prefix ? -1 : 1;
+
+        // Same first bytes; the shorter key's padding matched the other's bytes
+        const std::uint32_t shorter = lhs.length < rhs.length ? lhs.length : rhs.length;
+        if (shorter > PrefixLength)
+        {
+          int result = std::memcmp(lhs.rest, rhs.rest, shorter - PrefixLength);
+          if (result != 0)
+            return result;
+        }
+        return lhs.length < rhs.length ? -1 : (lhs.length > rhs.length ? 1 : 0);
+      }
+    };
+
+    StringAVLTree(unsigned ExpectedSize = 0);
+    void insert(const std::string& value);
+    void remove(const std::string& value);
+    void clear();
+    void reserve(unsigned n);
+    bool find(const std::string& value, unsigned &compares) const;
+    bool empty() const;
+    unsigned int size() const;
+    int height() const;
+
+  private:
+    //! Size of a block of key bytes
+    static const std::size_t BlockSize = 64 * 1024;
+
+    FlatAVLTree<Key> tree;                      //!< the keys
+    std::vector<std::unique_ptr<char[]>> blocks; //!< key bytes after the prefixes
+    char *blockNext;                            //!< first unused byte of the last block
+    std::size_t blockFree;                      //!< unused bytes at the end of the last block
+
+    static Key MakeKey(const std::string& value);
+    char *Store(const char *bytes, std::size_t length);
+};
+
+#endif
+//---------------------------------------------------------------------------
@@ -0,0 +1,666 @@
+#include <iostream>
+#include <map>
+#include <vector>
+#include <list>
+#include <memory>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <typeinfo>
+#include <sstream>
+#include <cstring>
+#include "BSTree.h"
+#include "AVLTree.h"
+#include "FlatAVLTree.h"
+#include "StringAVLTree.h"
+#include "EytzingerIndex.h"
+#include "PRNG.h"
+#include "ObjectAllocator.h"
+
+#define SHOW_COUNTS
+
+//*********************************************************************
+// Printing/Debugging
+//*********************************************************************
+static int Position;
+template <typename T>
+void SetTreePositions(const typename BSTree<T>::BinTreeNode *tree, 
+                      int depth, 
+                      std::map<const typename BSTree<T>::BinTreeNode *, 
+                      std::pair<int, int> >& NodePositions)
+{
+  if (!tree)
+    return;
+
+  SetTreePositions<T>(tree->left, depth + 1, NodePositions);
+  std::pair<int, int>XY(Position++, depth);
+  std::pair<const typename BSTree<T>::BinTreeNode *, std::pair<int, int> > pr(tree, XY);
+  NodePositions.insert(pr);
+  SetTreePositions<T>(tree->right, depth + 1, NodePositions);
+}
+
+template <typename T>
+void SetTreePositions(const BSTree<T> &tree, 
+                      std::map<const typename BSTree<T>::BinTreeNode *, 
+                      std::pair<int, int> >& NodePositions)
+{
+  Position = 0;
+  NodePositions.clear();
+  SetTreePositions<T>(tree.root(), 0, NodePositions);
+}
+
+template <typename T>
+std::vector<std::pair<const typename BSTree<T>::BinTreeNode *, int> >
+GetNodesAtLevel(int level, 
+                std::map<const typename BSTree<T>::BinTreeNode *, 
+                std::pair<int, int> >& NodePositions)
+{
+  std::vector<std::pair<const typename BSTree<T>::BinTreeNode *, int> >nodes;
+  typename std::map<const typename BSTree<T>::BinTreeNode *, std::pair<int, int> >::iterator it;
+  for (it = NodePositions.begin(); it != NodePositions.end(); ++it)
+  {
+    std::pair<int, int>XY = it->second;
+    if (XY.second == level)
+    {
+      std::pair<const typename BSTree<T>::BinTreeNode *, int> pr( it->first, XY.first);
+      nodes.push_back(pr);
+    }
+  }
+  return nodes;
+}  
+
+template <typename T>
+bool SortNodes(const std::pair<const typename BSTree<T>::BinTreeNode *, int>&a, 
+               const std::pair<const typename BSTree<T>::BinTreeNode *, int>&b)
+{
+  if (a.second < b.second)
+    return true;
+  else
+    return false;
+}
+
+template <typename T>
+class fSortNodes
+{
+public:
+  bool operator()(const std::pair<const typename BSTree<T>::BinTreeNode *, int>&a, 
+                  const std::pair<const typename BSTree<T>::BinTreeNode *, int>&b)
+  {
+    if (a.second < b.second)
+      return true;
+    else
+      return false;
+  }
+};
+
+template <typename T>
+void PrintBST(const BSTree<T> &tree)
+{
+  std::map<const typename BSTree<T>::BinTreeNode *, std::pair<int, int> > NodePositions;
+
+  SetTreePositions(tree, NodePositions);
+  int height = tree.height();
+  int offset = 0;
+  int fudge = 5;
+  for (int i = 0; i <= height; i++)
+  {
+    std::vector<std::pair<const typename BSTree<T>::BinTreeNode *, int> >nodes = GetNodesAtLevel<T> (i, NodePositions);
+    // Borland doesn't like the function, wants a function object
+    //std::sort(nodes.begin(), nodes.end(), SortNodes<T>);
+    std::sort(nodes.begin(), nodes.end(), fSortNodes<T>());
+    typename std::vector<std::pair<const typename BSTree<T>::BinTreeNode *, int> >::iterator iter;
+    char buffer[1024 * 2] = {0};
+    std::memset(buffer, ' ', 1024 * 2);
+
+    for (iter = nodes.begin(); iter != nodes.end(); ++iter)
+    {
+      //char data[60] = {0};
+      T value = (*iter).first->data;
+      //std::sprintf(data, "%g", value);  // <<**>>
+
+      std::stringstream ss;
+      #ifdef SHOW_COUNTS
+      ss << value << "[" << (*iter).first->count << "]";
+      #else
+      ss << value;
+      #endif
+
+      offset = (height / 2) + iter->second * fudge;  // fudge factor (change to 4 for big numbers)
+      //strncpy(buffer + offset, data, strlen(data));
+      strncpy(buffer + offset, ss.str().c_str(), ss.str().length());
+    }
+    buffer[offset + fudge * 2] = 0; // should handle 4 digits easily
+    std::cout << buffer << std::endl << std::endl;
+  }
+}
+
+const char *ReadableType(const char *name)
+{
+  if (std::strstr(name, "String"))
+    return "StringAVLTree";
+  else if (std::strstr(name, "Flat"))
+    return "FlatAVLTree";
+  else if (std::strstr(name, "AVL"))
+    return "AVLTree";
+  else
+    return "BSTree";
+}
+
+template <typename T>
+void PrintInfo(const T& tree)
+{
+  std::cout << "type: " << ReadableType(typeid(T).name()) << ", height: " << tree.height();
+  std::cout << ", nodes: " << tree.size() << std::endl;
+}
+
+template <typename T, typename U>
+void PrintFind(const T& tree, const U& value)
+{
+  unsigned compares = 0;
+  bool found = tree.find(value, compares);
+  if (found)
+    std::cout << "Value " << value << " found with " << compares << " compares\n";
+  else
+    std::cout << "Value " << value << " NOT found with " << compares << " compares\n";
+}
+
+template <typename It>
+void PrintRange(It first, It last)
+{
+  std::cout << "In order:";
+  for (; first != last; ++first)
+    std::cout << " " << *first;
+  std::cout << std::endl;
+}
+
+void PrintException(const char *test, const BSTException &e)
+{
+  std::cout << "Caught BSTException in " << test;
+  int value = e.code();
+  if (value == BSTException::E_NO_MEMORY)
+    std::cout << "E_NO_MEMORY" << std::endl;
+  else
+    std::cout << "Unknown error code." << std::endl;
+}
+
+//*********************************************************************
+// End Printing/Debugging
+//*********************************************************************
+
+int RandomInt(int low, int high)
+{
+  return Digipen::Utils::Random(low, high);
+}
+
+template <typename T>
+void SwapInt(T &a, T &b)
+{
+  T temp = a;
+  a = b;
+  b = temp;
+}
+
+template <typename T> void Shuffle(T *array, int count, int stride = 1)
+{
+  for (int i = 0; i < count; i += stride)
+  {
+    int r = RandomInt(0, count - 1);
+    SwapInt(array[i], array[r]);
+  }
+}
+
+void GetValues(int *array, int size)
+{
+  Digipen::Utils::srand(1, 2);
+  for (int i = 0; i < size; i++)
+    array[i] = i;
+
+  Shuffle(array, size);
+}
+
+//*********************************************************************
+// Tests
+//*********************************************************************
+
+template <typename T>
+void TestBuildSorted(void)
+{
+  T tree;
+  const int vals[] = {1, 2, 2, 3, 5, 5, 5, 8, 9, 12, 12, 15};
+  const int size = sizeof(vals) / sizeof(*vals);
+  const char *test = "TestBuildSorted - build_from_sorted with repeated values";
+
+  std::cout << "\n====================== " << test << " ======================\n";
+  std::cout << ReadableType(typeid(T).name()) << std::endl;
+  try
+  {
+    // Whatever was in the tree is replaced
+    tree.insert(100);
+    tree.build_from_sorted(vals, vals + size);
+
+    PrintInfo(tree);
+    PrintBST(tree);
+    PrintRange(tree.begin(), tree.end());
+    PrintFind(tree, 5);
+    PrintFind(tree, 12);
+    PrintFind(tree, 100);
+
+    // The tree is an ordinary tree afterwards
+    tree.insert(4);
+    tree.remove(2);
+    PrintInfo(tree);
+    PrintRange(tree.begin(), tree.end());
+  }
+  catch (const BSTException &e)
+  {
+    PrintException(test, e);
+  }
+  catch (...)
+  {
+    std::cout << "Caught unknown exception in " << test << std::endl;
+  }
+}
+
+template <typename T>
+void TestBuildUnsorted(void)
+{
+  T tree;
+  const int size = 15;
+  int vals[size];
+  GetValues(vals, size);
+  const char *test = "TestBuildUnsorted - build_from_sorted from an unsorted list";
+
+  std::cout << "\n====================== " << test << " ======================\n";
+  std::cout << ReadableType(typeid(T).name()) << std::endl;
+  try
+  {
+    std::list<int> values(vals, vals + size);
+    tree.build_from_sorted(values.begin(), values.end());
+
+    PrintInfo(tree);
+    PrintBST(tree);
+    for (int i = 0; i < static_cast<int>(tree.size()); i += 4)
+      std::cout << "Index " << i << ": " << tree[i]->data << std::endl;
+
+    tree.build_from_sorted(values.end(), values.end());
+    PrintInfo(tree);
+    if (tree.empty())
+      std::cout << "tree is empty\n";
+    else
+      std::cout << "tree is NOT empty\n";
+  }
+  catch (const BSTException &e)
+  {
+    PrintException(test, e);
+  }
+  catch (...)
+  {
+    std::cout << "Caught unknown exception in " << test << std::endl;
+  }
+}
+
+template <typename T>
+void TestBounds(void)
+{
+  T tree;
+  const int size = 12;
+  int vals[size];
+  GetValues(vals, size);
+  const char *test = "TestBounds - iterators, lower_bound/upper_bound, count_range";
+
+  std::cout << "\n====================== " << test << " ======================\n";
+  std::cout << ReadableType(typeid(T).name()) << std::endl;
+  try
+  {
+    // Even values 0 to 22, inserted in random order
+    for (int i = 0; i < size; i++)
+      tree.insert(vals[i] * 2);
+
+    PrintInfo(tree);
+    PrintRange(tree.begin(), tree.end());
+
+    const int probes[] = {-1, 0, 7, 8, 22, 23};
+    for (int value : probes)
+    {
+      typename T::const_iterator lower = tree.lower_bound(value);
+      typename T::const_iterator upper = tree.upper_bound(value);
+      std::cout << "lower_bound(" << value << "): ";
+      if (lower == tree.end())
+        std::cout << "end";
+      else
+        std::cout << *lower;
+      std::cout << ", upper_bound(" << value << "): ";
+      if (upper == tree.end())
+        std::cout << "end";
+      else
+        std::cout << *upper;
+      std::cout << std::endl;
+    }
+
+    std::cout << "From lower_bound(9) to upper_bound(15): ";
+    PrintRange(tree.lower_bound(9), tree.upper_bound(15));
+
+    const int ranges[][2] = {{0, 23}, {5, 15}, {6, 6}, {10, 11}, {15, 5}, {-10, 1}, {23, 100}};
+    for (const auto &range : ranges)
+      std::cout << "count_range(" << range[0] << ", " << range[1] << "): "
+                << tree.count_range(range[0], range[1]) << std::endl;
+
+    // Inserted in descending order a BSTree is one chain of left children,
+    // deeper than the path an iterator keeps in itself
+    T deep;
+    for (int i = 99; i >= 0; i--)
+      deep.insert(i);
+    int visited = 0;
+    bool in_order = true;
+    typename T::const_iterator middle = deep.end();
+    for (typename T::const_iterator it = deep.begin(); it != deep.end(); ++it, ++visited)
+    {
+      in_order = in_order && *it == visited;
+      if (visited == 10)
+        middle = it;
+    }
+    typename T::const_iterator copy = middle;
+    int from_lower = 0;
+    for (typename T::const_iterator it = deep.lower_bound(50); it != deep.end(); it++)
+      ++from_lower;
+    std::cout << "Descending 0-99: height " << deep.height() << ", visited " << visited
+              << ", in order " << (in_order ? "yes" : "no") << ", copy at " << *copy
+              << ", after it " << *++copy << ", from lower_bound(50) " << from_lower << std::endl;
+  }
+  catch (const BSTException &e)
+  {
+    PrintException(test, e);
+  }
+  catch (...)
+  {
+    std::cout << "Caught unknown exception in " << test << std::endl;
+  }
+}
+
+template <typename T>
+void TestFreeze(void)
+{
+  T tree;
+  const int size = 20;
+  int vals[size];
+  GetValues(vals, size);
+  const char *test = "TestFreeze - freeze into an EytzingerIndex";
+
+  std::cout << "\n====================== " << test << " ======================\n";
+  std::cout << ReadableType(typeid(T).name()) << std::endl;
+  try
+  {
+    for (int i = 0; i < size; i++)
+      tree.insert(vals[i] * 3);
+
+    EytzingerIndex<int> index = tree.freeze();
+    PrintInfo(tree);
+    std::cout << "index size: " << index.size() << std::endl;
+
+    // Same answers as the tree, whatever the tree's shape
+    int mismatches = 0;
+    for (int value = -1; value <= size * 3; value++)
+    {
+      unsigned tree_compares = 0, index_compares = 0;
+      if (tree.find(value, tree_compares) != index.find(value, index_compares))
+        mismatches++;
+    }
+    std::cout << "mismatches: " << mismatches << std::endl;
+    PrintFind(index, 0);
+    PrintFind(index, 30);
+    PrintFind(index, 31);
+    PrintFind(index, 57);
+
+    // Later changes to the tree leave the index alone
+    tree.clear();
+    PrintInfo(tree);
+    PrintFind(index, 30);
+
+    EytzingerIndex<int> empty = tree.freeze();
+    std::cout << "empty index: " << (empty.empty() ? "empty" : "NOT empty") << std::endl;
+    PrintFind(empty, 30);
+  }
+  catch (const BSTException &e)
+  {
+    PrintException(test, e);
+  }
+  catch (...)
+  {
+    std::cout << "Caught unknown exception in " << test << std::endl;
+  }
+}
+
+template <typename T>
+void TestFindBatch(void)
+{
+  T tree;
+  const int size = 10000;
+  const int keys_size = 2 * size + 10;
+  const char *test = "TestFindBatch - find_batch with 1 and 4 threads";
+
+  std::cout << "\n====================== " << test << " ======================\n";
+  std::cout << ReadableType(typeid(T).name()) << std::endl;
+  try
+  {
+    // Even values only, so half of the keys are found
+    std::vector<int> values(size);
+    for (int i = 0; i < size; i++)
+      values[static_cast<size_t>(i)] = 2 * i;
+    tree.build_from_sorted(values.begin(), values.end());
+
+    std::vector<int> keys(keys_size);
+    for (int i = 0; i < keys_size; i++)
+      keys[static_cast<size_t>(i)] = i - 5;
+    Digipen::Utils::srand(3, 4);
+    Shuffle(keys.data(), keys_size);
+
+    PrintInfo(tree);
+    const unsigned threads[] = {1, 4};
+    for (unsigned count : threads)
+    {
+      std::unique_ptr<bool[]> found(new bool[keys_size]);
+      tree.find_batch(keys.data(), keys.size(), found.get(), count);
+
+      int hits = 0, mismatches = 0;
+      for (int i = 0; i < keys_size; i++)
+      {
+        unsigned compares = 0;
+        if (found[i])
+          hits++;
+        if (found[i] != tree.find(keys[static_cast<size_t>(i)], compares))
+          mismatches++;
+      }
+      std::cout << "threads: " << count << ", keys: " << keys_size << ", found: " << hits
+                << ", mismatches: " << mismatches << std::endl;
+    }
+
+    tree.find_batch(keys.data(), 0, nullptr, 4);
+    std::cout << "no keys: ok" << std::endl;
+  }
+  catch (const BSTException &e)
+  {
+    PrintException(test, e);
+  }
+  catch (...)
+  {
+    std::cout << "Caught unknown exception in " << test << std::endl;
+  }
+}
+
+template <typename T>
+void TestFlat(void)
+{
+  T tree;
+  AVLTree<int> reference;
+  const int size = 30;
+  int vals[size];
+  GetValues(vals, size);
+  const char *test = "TestFlat - random insert/remove against AVLTree";
+
+  std::cout << "\n====================== " << test << " ======================\n";
+  std::cout << ReadableType(typeid(T).name()) << std::endl;
+  try
+  {
+    for (int i = 0; i < size; i++)
+    {
+      tree.insert(vals[i]);
+      reference.insert(vals[i]);
+    }
+    tree.insert(vals[0]); // already there
+    PrintInfo(tree);
+    PrintInfo(reference);
+
+    // Every other value out, then some back in, reusing the freed nodes
+    for (int i = 0; i < size; i += 2)
+    {
+      tree.remove(vals[i]);
+      reference.remove(vals[i]);
+    }
+    tree.remove(1000); // not there
+    for (int i = 0; i < size; i += 6)
+    {
+      tree.insert(vals[i]);
+      reference.insert(vals[i]);
+    }
+    PrintInfo(tree);
+    PrintInfo(reference);
+
+    std::cout << "Index:";
+    for (int i = 0; i < static_cast<int>(tree.size()); i++)
+      std::cout << " " << tree[i]->data;
+    std::cout << std::endl;
+
+    int mismatches = 0;
+    for (int value = -1; value <= size; value++)
+    {
+      unsigned compares = 0, reference_compares = 0;
+      if (tree.find(value, compares) != reference.find(value, reference_compares) ||
+          compares != reference_compares)
+        mismatches++;
+    }
+    std::cout << "mismatches with AVLTree: " << mismatches << std::endl;
+    PrintFind(tree, vals[1]);
+    PrintFind(tree, vals[2]);
+
+    tree.clear();
+    PrintInfo(tree);
+    if (tree.empty())
+      std::cout << "tree is empty\n";
+    else
+      std::cout << "tree is NOT empty\n";
+  }
+  catch (const BSTException &e)
+  {
+    PrintException(test, e);
+  }
+  catch (...)
+  {
+    std::cout << "Caught unknown exception in " << test << std::endl;
+  }
+}
+
+template <typename T>
+void TestStringTree(void)
+{
+  T tree;
+  AVLTree<std::string> reference;
+  const char *words[] = {"INTERNATIONAL", "DOG", "INTERN", "INTERNATIONALE", "CAT", "INTERNS",
+                         "ABCDEFGH", "ABCDEFGHI", "ABCDEFG", "", "ZEBRA", "INTERNATIONALLY",
+                         "DOG", "ABCDEFGHIJKLMNOPQRSTUVWXYZ", "ABCDEFGHIJKLMNOPQRSTUVWXYY"};
+  const int size = sizeof(words) / sizeof(*words);
+  const char *test = "TestStringTree - StringAVLTree against AVLTree<std::string>";
+
+  std::cout << "\n====================== " << test << " ======================\n";
+  std::cout << ReadableType(typeid(T).name()) << std::endl;
+  try
+  {
+    for (int i = 0; i < size; i++)
+    {
+      tree.insert(words[i]);
+      reference.insert(words[i]);
+    }
+    PrintInfo(tree);
+    PrintInfo(reference);
+
+    const char *probes[] = {"INTERN", "INTERNATIONALE", "INTERNATIONA", "ABCDEFGH", "ABCDEFGHIJ",
+                            "ABCDEFGHIJKLMNOPQRSTUVWXYZ", "ABCDEFGHIJKLMNOPQRSTUVWXYX", "ZEBRAS"};
+    for (const char *probe : probes)
+    {
+      unsigned compares = 0, reference_compares = 0;
+      bool found = tree.find(probe, compares);
+      bool reference_found = reference.find(probe, reference_compares);
+      std::cout << "Value " << probe << (found ? " found" : " NOT found") << " with " << compares
+                << " compares (AVLTree: " << (reference_found ? "found" : "NOT found") << " with "
+                << reference_compares << ")\n";
+    }
+    unsigned compares = 0;
+    std::cout << "Empty string " << (tree.find("", compares) ? "found" : "NOT found") << std::endl;
+
+    tree.remove("INTERNATIONAL");
+    tree.remove("CAT");
+    tree.remove("NOT THERE");
+    PrintInfo(tree);
+    PrintFind(tree, "INTERNATIONAL");
+    PrintFind(tree, "INTERNATIONALE");
+
+    tree.clear();
+    PrintInfo(tree);
+    tree.reserve(4);
+    tree.insert("AFTER CLEAR, A LONGER KEY");
+    PrintFind(tree, "AFTER CLEAR, A LONGER KEY");
+    PrintInfo(tree);
+  }
+  catch (const BSTException &e)
+  {
+    PrintException(test, e);
+  }
+  catch (...)
+  {
+    std::cout << "Caught unknown exception in " << test << std::endl;
+  }
+}
+
+//***********************************************************************
+//***********************************************************************
+//***********************************************************************
+
+typedef void (*TestFn)(void);
+
+void ExecuteTest(TestFn fn)
+{
+  fn();
+}
+
+int main(int argc, char **argv)
+{
+  int test_num = 0;
+  if (argc > 1)
+    test_num = std::atoi(argv[1]);
+
+  typedef int T;
+  TestFn Tests[] = {TestBuildSorted<BSTree<T> >,    //  1 build with repeated values kept
+                    TestBuildSorted<AVLTree<T> >,   //  2 build with repeated values dropped
+                    TestBuildUnsorted<BSTree<T> >,  //  3 build from an unsorted list
+                    TestBuildUnsorted<AVLTree<T> >, //  4 build from an unsorted list
+                    TestBounds<BSTree<T> >,         //  5 iterators and bounds
+                    TestBounds<AVLTree<T> >,        //  6 iterators and bounds
+                    TestFreeze<BSTree<T> >,         //  7 Eytzinger index
+                    TestFreeze<AVLTree<T> >,        //  8 Eytzinger index
+                    TestFindBatch<AVLTree<T> >,     //  9 batched lookups
+                    TestFlat<FlatAVLTree<T> >,      // 10 flat AVL tree
+                    TestStringTree<StringAVLTree>,  // 11 string AVL tree
+                   };
+
+  int num = sizeof(Tests) / sizeof(*Tests);
+  if (test_num == 0)
+  {
+    for (int i = 0; i < num; i++)
+      ExecuteTest(Tests[i]);
+  }
+  else if (test_num > 0 && test_num <= num)
+  {
+    ExecuteTest(Tests[test_num - 1]);
+  }
+
+  return 0;
+}
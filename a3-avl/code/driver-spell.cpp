@@ -11,6 +11,7 @@
 
 #include "BSTree.h"
 #include "AVLTree.h"
+#include "StringAVLTree.h"
 #include "PRNG.h"
 #include "ObjectAllocator.h"
 
@@ -136,9 +137,17 @@ void PrintBST(const BSTree<T> &tree)
   }
 }
 
+// StringAVLTree has no root() to walk
+void PrintBST(const StringAVLTree &)
+{
+  std::cout << "(StringAVLTree does not show its tree)" << std::endl;
+}
+
 const char *ReadableType(const char *name)
 {
-  if (std::strstr(name, "AVL"))
+  if (std::strstr(name, "String"))
+    return "StringAVLTree";
+  else if (std::strstr(name, "AVL"))
     return "AVLTree";
   else
     return "BSTree";
@@ -444,6 +453,8 @@ int main(int argc, char **argv)
                        {TestSpellCheck1<AVLTree<U> >, 10000, 5000}, 
                        {TestSpellCheck2<BSTree<U> >,  10000, 5000}, 
                        {TestSpellCheck2<AVLTree<U> >, 10000, 5000}, 
+                       {TestSpellCheck1<StringAVLTree>, 10000, 5000},
+                       {TestSpellCheck2<StringAVLTree>, 10000, 5000},
                       };
 
   int num = sizeof(Tests) / sizeof(*Tests);